@@ -29,10 +29,13 @@
  *  @n https://www.bosch-sensortec.com/bst/products/all_products/bme280
  */
 
+#include <string.h>
+
 /* XDCtools Header files */
 #include <xdc/std.h>
 #include <xdc/runtime/System.h>
 #include <xdc/runtime/Error.h>
+#include <xdc/runtime/Timestamp.h>
 
 /* BIOS Header files */
 #include <ti/sysbios/BIOS.h>
@@ -46,164 +49,367 @@
 #include "bme280.h"
 
 
-static I2C_Handle i2cbus;  /// @brief Local persistent copy of the I2C Handle passed during BME280_init()
-static Uint8 i2cAddr;  /// @brief Local persistent copy of the I2C slave address specified during BME280_init()
-static Uint8 _bme280_calibration[33];  /// @brief Local persistent copy of the BME280's unique calibration values discovered during BME280_open()
-static Uint8 _bme280_ctrl_meas;  /// @brief Local copy of CTRL_MEAS settings, to save current OSRS params when modifying CTRL_MEAS:mode[]
+static BME280_Object _bme280_default;  /// @brief Instance used by the handle-less API (BME280_init(), BME280_open(), BME280_read(), ...)
+static BME280_BusRecoveryFxn _bme280_busRecovery;  /// @brief Optional hook run before each transfer retry
+
+/// @brief Ticks left until <deadline>; negative once it has passed.  Wraparound-safe.
+static inline Int32 _bme280_remaining(Uint32 deadline)
+{
+	return (Int32)(deadline - Clock_getTicks());
+}
+
+#ifdef BME280_I2C_HAS_CANCEL
+/// @brief Semaphore_pend() timeout covering the time left until <deadline>
+static inline UInt _bme280_pendTimeout(Bool bounded, Uint32 deadline)
+{
+	Int32 remaining;
+
+	if (!bounded) {
+		return BIOS_WAIT_FOREVER;
+	}
+	remaining = _bme280_remaining(deadline);
+	return remaining > 0 ? (UInt)remaining : 0;
+}
+
+/// @brief I2C callback to install as I2C_Params.transferCallbackFxn when the bus is opened in I2C_MODE_CALLBACK
+/// @details Every transaction issued by this driver carries its instance in I2C_Transaction.arg.
+Void BME280_transferCallback(I2C_Handle hand, I2C_Transaction *txn, bool status)
+{
+	BME280_Handle handle = (BME280_Handle)txn->arg;
+
+	handle->txnStatus = status;
+	Semaphore_post(Semaphore_handle(&handle->txnDone));
+}
+
+/// @brief Issue handle->txn in callback mode and wait for it until <deadline>
+/// @details A transfer still running at <deadline> is cancelled, and given BME280_I2C_CANCEL_WAIT ticks to call
+///          back; if it doesn't, handle->txn stays with the I2C driver until _bme280_claimTxn() gets it back.
+static BME280_Result _bme280_transferAsync(BME280_Handle handle, Bool bounded, Uint32 deadline)
+{
+	Semaphore_Handle done = Semaphore_handle(&handle->txnDone);
+
+	if (!I2C_transfer(handle->i2cbus, &handle->txn)) {
+		return BME280_RESULT_BUS_ERROR;  // Could not even be queued
+	}
+	if (Semaphore_pend(done, _bme280_pendTimeout(bounded, deadline))) {
+		return handle->txnStatus ? BME280_RESULT_OK : BME280_RESULT_BUS_ERROR;
+	}
+	I2C_cancel(handle->i2cbus);
+	if (!Semaphore_pend(done, BME280_I2C_CANCEL_WAIT)) {
+		handle->txnInFlight = true;
+	}
+	return BME280_RESULT_TIMEOUT;
+}
+#endif
+
+/// @brief Take handle->txn and its buffers back from the I2C driver before they are filled in
+/// @details A transfer cancelled in callback mode that has not called back yet still belongs to the I2C driver,
+///          which may read handle->txn and handle->txBuf or write handle->rxBuf at any time until it does.
+static BME280_Result _bme280_claimTxn(BME280_Handle handle, Bool bounded, Uint32 deadline)
+{
+	#ifdef BME280_I2C_HAS_CANCEL
+	if (handle->txnInFlight) {
+		if (!Semaphore_pend(Semaphore_handle(&handle->txnDone), _bme280_pendTimeout(bounded, deadline))) {
+			return BME280_RESULT_TIMEOUT;
+		}
+		handle->txnInFlight = false;
+	}
+	#endif
+	return BME280_RESULT_OK;
+}
+
+/// @brief Issue handle->txn once
+/// @details In callback mode the wait for completion is bounded by <deadline> (see _bme280_transferAsync()).  In
+///          blocking mode nothing can interrupt I2C_transfer(), so the only bound applied is that no transfer is
+///          started once <deadline> has passed.
+static BME280_Result _bme280_transferOnce(BME280_Handle handle, Bool bounded, Uint32 deadline)
+{
+	if (bounded && _bme280_remaining(deadline) <= 0) {
+		return BME280_RESULT_TIMEOUT;
+	}
+
+	#ifdef BME280_I2C_HAS_CANCEL
+	if (handle->callbackMode) {
+		return _bme280_transferAsync(handle, bounded, deadline);
+	}
+	#endif
+	return I2C_transfer(handle->i2cbus, &handle->txn) ? BME280_RESULT_OK : BME280_RESULT_BUS_ERROR;
+}
+
+/// @brief Perform handle->txn, retrying with bus recovery on failure
+/// @details When <bounded> is true, no attempt is started after <deadline> and no retry is started unless it
+///          can complete before <deadline>.  A timed out transfer is not retried.
+///          Time spent on the attempts is accumulated in handle->busyTime.
+static BME280_Result _bme280_transfer(BME280_Handle handle, Bool bounded, Uint32 deadline)
+{
+	BME280_Result res = BME280_RESULT_BUS_ERROR;
+	Uint8 attempt;
+	Uint32 t0;
+
+	for (attempt = 0; attempt <= BME280_I2C_RETRIES; attempt++) {
+		if (attempt > 0) {
+			if (bounded && _bme280_remaining(deadline) <= BME280_I2C_RETRY_WAIT) {
+				break;  // Not enough time left to recover and try again
+			}
+			if (_bme280_busRecovery != NULL) {
+				_bme280_busRecovery(handle->i2cbus);
+			}
+			Task_sleep(BME280_I2C_RETRY_WAIT);
+		}
+		t0 = Timestamp_get32();
+		res = _bme280_transferOnce(handle, bounded, deadline);
+		handle->busyTime += Timestamp_get32() - t0;
+		if (res != BME280_RESULT_BUS_ERROR) {
+			return res;
+		}
+		#ifdef BME280_DEBUG_TRANSFER
+		System_printf("BME280 0x%x: I2C transfer to reg 0x%x failed (attempt %u)\r\n", handle->i2cAddr, handle->txBuf[0], attempt + 1);
+		System_flush();
+		#endif
+	}
+	return res;
+}
+
+/// @brief Checked burst read of <count> registers starting at <memAddress>
+/// @details Data lands in handle->rxBuf first and is only copied to <buf> on success, so a failed or
+///          late-completing transfer never writes caller memory.
+static BME280_Result _bme280_readRegs(BME280_Handle handle, Uint8 memAddress, Uint8 *buf, Uint8 count, Bool bounded, Uint32 deadline)
+{
+	BME280_Result res;
+
+	res = _bme280_claimTxn(handle, bounded, deadline);
+	if (res != BME280_RESULT_OK) {
+		return res;
+	}
+	handle->txBuf[0] = memAddress;
+	handle->txn.readBuf = handle->rxBuf;
+	handle->txn.readCount = count;
+	handle->txn.writeBuf = handle->txBuf;
+	handle->txn.writeCount = 1;
+	handle->txn.slaveAddress = handle->i2cAddr;
+	handle->txn.arg = handle;
+
+	res = _bme280_transfer(handle, bounded, deadline);
+	if (res == BME280_RESULT_OK && count > 0) {
+		memcpy(buf, handle->rxBuf, count);
+	}
+	return res;
+}
+
+/// @brief Checked write of a single 8-bit register
+static BME280_Result _bme280_writeReg(BME280_Handle handle, Uint8 memAddress, Uint8 value, Bool bounded, Uint32 deadline)
+{
+	BME280_Result res;
+
+	res = _bme280_claimTxn(handle, bounded, deadline);
+	if (res != BME280_RESULT_OK) {
+		return res;
+	}
+	handle->txBuf[0] = memAddress;
+	handle->txBuf[1] = value;
+	handle->txn.readBuf = NULL;
+	handle->txn.readCount = 0;
+	handle->txn.writeBuf = handle->txBuf;
+	handle->txn.writeCount = 2;
+	handle->txn.slaveAddress = handle->i2cAddr;
+	handle->txn.arg = handle;
+
+	return _bme280_transfer(handle, bounded, deadline);
+}
 
 /// @brief Driver initialization
 /// @details Performed by user with a known-valid I2C_Handle and slave address
 Void BME280_init(I2C_Handle hand, Uint8 addr)
 {
-	i2cbus = hand;
-	i2cAddr = addr;
+	static Bool constructed = false;
+
+	if (!constructed) {
+		BME280_construct(&_bme280_default, hand, addr);
+		constructed = true;
+	} else {
+		// Re-init: keep the already constructed Semaphore
+		_bme280_default.i2cbus = hand;
+		_bme280_default.i2cAddr = addr;
+		_bme280_default.opened = false;
+		_bme280_default.pending = false;
+	}
+}
+
+/// @brief Initialize a driver instance for the sensor at <addr> on <hand>
+BME280_Handle BME280_construct(BME280_Object *obj, I2C_Handle hand, Uint8 addr)
+{
+	#ifdef BME280_I2C_HAS_CANCEL
+	Semaphore_Params semParams;
+	#endif
+
+	memset(obj, 0, sizeof(BME280_Object));
+	obj->i2cbus = hand;
+	obj->i2cAddr = addr;
+	#ifdef BME280_I2C_HAS_CANCEL
+	Semaphore_Params_init(&semParams);
+	semParams.mode = Semaphore_Mode_BINARY;
+	Semaphore_construct(&obj->txnDone, 0, &semParams);
+	#endif
+	return obj;
+}
+
+/// @brief Install (or clear with NULL) the bus recovery hook used between transfer retries
+Void BME280_setBusRecoveryFxn(BME280_BusRecoveryFxn fxn)
+{
+	_bme280_busRecovery = fxn;
+}
+
+#ifdef BME280_I2C_HAS_CANCEL
+/// @brief Declare that the default instance's I2C_Handle was opened in callback mode
+Void BME280_setCallbackMode(Bool enable)
+{
+	BME280_Handle_setCallbackMode(&_bme280_default, enable);
+}
+
+/// @brief Declare that the instance's I2C_Handle was opened in I2C_MODE_CALLBACK with BME280_transferCallback()
+Void BME280_Handle_setCallbackMode(BME280_Handle handle, Bool enable)
+{
+	handle->callbackMode = enable;
+}
+#endif
+
+/// @brief Make contact with the chip and read calibration registers
+Bool BME280_open()
+{
+	return BME280_Handle_open(&_bme280_default);
 }
 
 /// @brief Make contact with the chip and read calibration registers
 /// @details This function checks the CHIP_ID register to verify we're talking to a Bosch Sensortec BME280
-///          and then pulls the calibration constants into a local persistent buffer.
+///          and then pulls the calibration constants into the instance's persistent buffer.
 /// @returns true if everything goes well, false if I2C communication fails or if the CHIP_ID is not correct.
-Bool BME280_open()
+Bool BME280_Handle_open(BME280_Handle handle)
 {
 	Uint8 readId;
 
+	handle->opened = false;
+	handle->pending = false;
+
 	// Verify chip identification, reset chip
 	Task_sleep(BME280_RESET_SETTLING_TIME);
 
 	// Find Chip ID
-	readId = BME280_readReg(BME280_REG_ID);
-	if (readId != 0x60) { // Not a BME280?
+	if (_bme280_readRegs(handle, BME280_REG_ID, &readId, 1, false, 0) != BME280_RESULT_OK) {
+        #ifdef BME280_DEBUG_OPEN
+		System_printf("Error: BME280_open() failed to read CHIP_ID over I2C!\r\n");
+		System_flush();
+        #endif
+		return false;
+	}
+	if (readId != BME280_CHIPID) { // Not a BME280?
         #ifdef BME280_DEBUG_OPEN
 		System_printf("Error: BME280_open() read I2C bus for CHIP_ID and found invalid ID!\r\n");
 		System_flush();
         #endif
 		return false;
 	}
-	BME280_writeReg(BME280_REG_RESET, BME280_RESET_ASSERT);
+	if (_bme280_writeReg(handle, BME280_REG_RESET, BME280_RESET_ASSERT, false, 0) != BME280_RESULT_OK) {
+		return false;
+	}
 	Task_sleep(BME280_RESET_SETTLING_TIME);
 	#ifdef BME280_DEBUG_OPEN
-	System_printf("BME280_open: post-softreset ctrl_meas: %u\r\n", BME280_readReg(BME280_REG_CTRL_MEAS));
+	System_printf("BME280_open: post-softreset ctrl_meas: %u\r\n", BME280_Handle_readReg(handle, BME280_REG_CTRL_MEAS));
 	System_flush();
 	#endif
 
-	// Read calibration constants and init chip parameters
-	I2C_Transaction txn;
-	Uint8 regAddr;
-	txn.slaveAddress = i2cAddr;
-	txn.writeBuf = &regAddr;
-	txn.writeCount = 1;
-
-	regAddr = BME280_REG_CALIB00;
-	txn.readBuf = &_bme280_calibration[0];
-	txn.readCount = 26;
-	I2C_transfer(i2cbus, &txn);
-	regAddr = BME280_REG_CALIB26;
-	txn.readBuf = &_bme280_calibration[26];
-	txn.readCount = 6;
-	I2C_transfer(i2cbus, &txn);
-
-	BME280_writeReg(BME280_REG_CTRL_HUM, BME280_CTRL_HUM_OSRS__4);                // defaults we're using
-	_bme280_ctrl_meas = BME280_CTRL_MEAS_OSRS_T__4 | BME280_CTRL_MEAS_OSRS_P__4;  //
-	BME280_writeReg(BME280_REG_CTRL_MEAS, _bme280_ctrl_meas | BME280_CTRL_MEAS_MODE_SLEEP);
+	// Read calibration constants (dig_H2..dig_H6 live in 0xE1-0xE7) and init chip parameters
+	if (_bme280_readRegs(handle, BME280_REG_CALIB00, &handle->calibration[0], 26, false, 0) != BME280_RESULT_OK ||
+	    _bme280_readRegs(handle, BME280_REG_CALIB26, &handle->calibration[26], 7, false, 0) != BME280_RESULT_OK) {
+        #ifdef BME280_DEBUG_OPEN
+		System_printf("Error: BME280_open() failed to read calibration registers!\r\n");
+		System_flush();
+        #endif
+		return false;
+	}
+
+	handle->ctrl_meas = BME280_CTRL_MEAS_OSRS_T__4 | BME280_CTRL_MEAS_OSRS_P__4;  // defaults we're using
+	if (_bme280_writeReg(handle, BME280_REG_CTRL_HUM, BME280_CTRL_HUM_OSRS__4, false, 0) != BME280_RESULT_OK ||
+	    _bme280_writeReg(handle, BME280_REG_CTRL_MEAS, handle->ctrl_meas | BME280_CTRL_MEAS_MODE_SLEEP, false, 0) != BME280_RESULT_OK) {
+		return false;
+	}
 
 	#ifdef BME280_DEBUG_OPEN
-	System_printf("BME280_open: post-config ctrl_meas: %u\r\n", BME280_readReg(BME280_REG_CTRL_MEAS));
-	System_printf("BME280_open: post-config status: %u\r\n", BME280_readReg(BME280_REG_STATUS));
+	System_printf("BME280_open: post-config ctrl_meas: %u\r\n", BME280_Handle_readReg(handle, BME280_REG_CTRL_MEAS));
+	System_printf("BME280_open: post-config status: %u\r\n", BME280_Handle_readReg(handle, BME280_REG_STATUS));
 	System_flush();
 	#endif
 
+	handle->opened = true;
 	return true;
 }
 
 /// @brief Reset chip
 Bool BME280_close()
 {
-	BME280_writeReg(BME280_REG_RESET, BME280_RESET_ASSERT);
-	_bme280_ctrl_meas = 0;
-	return true;
+	return BME280_Handle_close(&_bme280_default);
+}
+
+/// @brief Reset chip
+/// @returns false if the RESET command could not be delivered
+Bool BME280_Handle_close(BME280_Handle handle)
+{
+	handle->opened = false;
+	handle->pending = false;
+	handle->ctrl_meas = 0;
+	return _bme280_writeReg(handle, BME280_REG_RESET, BME280_RESET_ASSERT, false, 0) == BME280_RESULT_OK;
 }
 
 /// @brief Internal API call for setting the current memory pointer.  Not used anywhere though...
 Void BME280_setAddress(Uint8 memAddress)
 {
-	I2C_Transaction txn;
-	Uint8 regAddr = memAddress;
-
-	txn.readBuf = NULL;
-	txn.readCount = 0;
-	txn.writeBuf = &regAddr;
-	txn.writeCount = 1;
-	txn.slaveAddress = i2cAddr;
-
-	I2C_transfer(i2cbus, &txn);
+	_bme280_readRegs(&_bme280_default, memAddress, NULL, 0, false, 0);
 }
 
 /// @brief Write a single 8-bit value to a specified memory address
 Void BME280_writeReg(Uint8 memAddress, Uint8 value)
 {
-	I2C_Transaction txn;
-	Uint8 wrBuf[2];
-
-	txn.readBuf = NULL;
-	txn.readCount = 0;
-	txn.writeBuf = wrBuf;
-	txn.writeCount = 2;
-	txn.slaveAddress = i2cAddr;
-
-	wrBuf[0] = memAddress;
-	wrBuf[1] = value;
-
-	I2C_transfer(i2cbus, &txn);
+	_bme280_writeReg(&_bme280_default, memAddress, value, false, 0);
 }
 
 /// @brief Read a single 8-bit value from the specified memory address
 Uint8 BME280_readReg(Uint8 memAddress)
 {
-	I2C_Transaction txn;
-	Uint8 regAddr = memAddress;
-	Uint8 rdBuf;
+	return BME280_Handle_readReg(&_bme280_default, memAddress);
+}
 
-	txn.readBuf = &rdBuf;
-	txn.readCount = 1;
-	txn.writeBuf = &regAddr;
-	txn.writeCount = 1;
-	txn.slaveAddress = i2cAddr;
+/// @brief Read a single 8-bit value from the specified memory address
+/// @details Returns 0 if the transfer fails; use the deadline-bounded API where errors matter.
+Uint8 BME280_Handle_readReg(BME280_Handle handle, Uint8 memAddress)
+{
+	Uint8 rdBuf = 0;
 
-	I2C_transfer(i2cbus, &txn);
+	if (_bme280_readRegs(handle, memAddress, &rdBuf, 1, false, 0) != BME280_RESULT_OK) {
+		return 0;
+	}
 	return rdBuf;
 }
 
 /// @brief Read a 16-bit value Big-Endian from the specified memory address
+/// @details Returns 0 if the transfer fails.
 Uint16 BME280_readWord(Uint8 memAddress)
 {
-	I2C_Transaction txn;
-	Uint8 regAddr = memAddress;
 	Uint8 rdBuf[2];
 
-	txn.readBuf = &rdBuf;
-	txn.readCount = 2;
-	txn.writeBuf = &regAddr;
-	txn.writeCount = 1;
-	txn.slaveAddress = i2cAddr;
-
-	I2C_transfer(i2cbus, &txn);
+	if (_bme280_readRegs(&_bme280_default, memAddress, rdBuf, 2, false, 0) != BME280_RESULT_OK) {
+		return 0;
+	}
 	return ((Uint16)rdBuf[0] << 8) | (Uint16)rdBuf[1];
 }
 
 /// @brief Read a 20-bit (MSB/LSB/XLSB) Big-Endian value from the specified memory address
+/// @details Returns 0 if the transfer fails.
 Uint32 BME280_readWord20(Uint8 memAddress)
 {
-	I2C_Transaction txn;
-	Uint8 regAddr = memAddress;
 	Uint8 rdBuf[3];
 
-	txn.readBuf = &rdBuf;
-	txn.readCount = 3;
-	txn.writeBuf = &regAddr;
-	txn.writeCount = 1;
-	txn.slaveAddress = i2cAddr;
-
-	I2C_transfer(i2cbus, &txn);
+	if (_bme280_readRegs(&_bme280_default, memAddress, rdBuf, 3, false, 0) != BME280_RESULT_OK) {
+		return 0;
+	}
 	return ((Uint32)rdBuf[0] << 12) | ((Uint32)rdBuf[1] << 4) | ((Uint32)rdBuf[2] >> 4);
 }
 
@@ -212,19 +418,52 @@ Uint32 BME280_readWord20(Uint8 memAddress)
 ///          returns a pointer to this buffer.
 static BME280_RawData _rawData;
 
+/// @brief Burst-read PRESS/TEMP/HUM and fan the results out into <out>
+/// @details <out> is left untouched unless the transfer succeeds and the data is not the reset value.
+static BME280_Result _bme280_fetch(BME280_Handle handle, BME280_RawData *out, Bool bounded, Uint32 deadline)
+{
+	Uint8 rdBuf[8];
+	Uint32 temperature_raw;
+	BME280_Result res;
+
+	res = _bme280_readRegs(handle, BME280_REG_PRESSURE, rdBuf, 8, bounded, deadline);
+	if (res != BME280_RESULT_OK) {
+		return res;
+	}
+
+	temperature_raw = ((Uint32)rdBuf[3] << 12) | ((Uint32)rdBuf[4] << 4) | ((Uint32)rdBuf[5] >> 4);
+	if (temperature_raw == BME280_RAW_NODATA) {
+		return BME280_RESULT_NO_DATA;  // Temperature is always enabled, so this means no conversion ever ran
+	}
+
+	// Fan out results
+	out->humidity_raw = ((Uint16)rdBuf[6] << 8) | (Uint16)rdBuf[7];
+	out->temperature_raw = temperature_raw;
+	out->pressure_raw = ((Uint32)rdBuf[0] << 12) | ((Uint32)rdBuf[1] << 4) | ((Uint32)rdBuf[2] >> 4);
+
+	return BME280_RESULT_OK;
+}
+
 /// @brief Collect current data
 /// @details This will first poll the STATUS register to ascertain no measurements are in progress; if they are, it
 ///          will perform Task_sleep() and poll again.  Since this uses Task_sleep(), this function must ALWAYS
 ///          be run within Task context e.g. not within a Swi or a Clock callback.
 ///          The STATUS register poll will start with a 2ms sleep and double the time until <timeout> is exceeded.
 ///          When timeout = 0, it will poll indefinitely.
+///          Returns NULL if the timeout expires or an I2C transfer fails.
 BME280_RawData * BME280_readMeasurements(Uint16 timeout)
 {
 	Uint16 status_delay = BME280_STATUS_MINIMUM_WAIT;
 	Uint32 total_delay = 0;
 	Uint8 stat = 0;
 
-	while ( (stat = BME280_readReg(BME280_REG_STATUS)) & (BME280_STATUS_MEASURING | BME280_STATUS_IM_UPDATE) ) {
+	while (1) {
+		if (_bme280_readRegs(&_bme280_default, BME280_REG_STATUS, &stat, 1, false, 0) != BME280_RESULT_OK) {
+			return NULL;
+		}
+		if (!(stat & (BME280_STATUS_MEASURING | BME280_STATUS_IM_UPDATE))) {
+			break;
+		}
 		#ifdef BME280_DEBUG_STATUS_POLLING
 		System_printf("STATUS=%u\r\n", stat);
 		System_flush();
@@ -241,34 +480,141 @@ BME280_RawData * BME280_readMeasurements(Uint16 timeout)
 		}
 	}
 
-	I2C_Transaction txn;
-	Uint8 regAddr = BME280_REG_PRESSURE;
-	Uint8 rdBuf[8];
+	if (_bme280_fetch(&_bme280_default, &_rawData, false, 0) != BME280_RESULT_OK) {
+		return NULL;
+	}
+	return &_rawData;
+}
 
-	txn.readBuf = &rdBuf;
-	txn.readCount = 8;
-	txn.writeBuf = &regAddr;
-	txn.writeCount = 1;
-	txn.slaveAddress = i2cAddr;
+/// @brief Initiate a Forced measurement without waiting for it
+BME280_Result BME280_start(Uint32 deadline)
+{
+	return BME280_Handle_start(&_bme280_default, deadline);
+}
 
-	I2C_transfer(i2cbus, &txn);
+/// @brief Initiate a Forced measurement without waiting for it
+BME280_Result BME280_Handle_start(BME280_Handle handle, Uint32 deadline)
+{
+	BME280_Result res;
 
-	// Fan out results
-	_rawData.humidity_raw = ((Uint16)rdBuf[6] << 8) | (Uint16)rdBuf[7];
-	_rawData.temperature_raw = ((Uint32)rdBuf[3] << 12) | ((Uint32)rdBuf[4] << 4) | ((Uint32)rdBuf[5] >> 4);
-	_rawData.pressure_raw = ((Uint32)rdBuf[0] << 12) | ((Uint32)rdBuf[1] << 4) | ((Uint32)rdBuf[2] >> 4);
+	if (!handle->opened) {
+		return BME280_RESULT_NOT_OPEN;
+	}
+	handle->pending = false;
+	res = _bme280_writeReg(handle, BME280_REG_CTRL_MEAS, BME280_CTRL_MEAS_MODE_FORCED | handle->ctrl_meas, true, deadline);
+	if (res != BME280_RESULT_OK) {
+		return res;
+	}
+	handle->startTime = Clock_getTicks();
+	handle->pending = true;
+	return BME280_RESULT_OK;
+}
 
-	return &_rawData;
+/// @brief Sleep until the pending conversion has had a head start of <BME280_STATUS_MINIMUM_WAIT> ticks
+Void BME280_waitConversion(Uint32 deadline)
+{
+	BME280_Handle_waitConversion(&_bme280_default, deadline);
+}
+
+/// @brief Sleep until the pending conversion has had a head start of <BME280_STATUS_MINIMUM_WAIT> ticks
+/// @details Measured from BME280_Handle_start(), so when several sensors are started back to back only the
+///          first wait actually sleeps.
+Void BME280_Handle_waitConversion(BME280_Handle handle, Uint32 deadline)
+{
+	Int32 remaining, wait;
+
+	if (!handle->pending) {
+		return;
+	}
+	wait = (Int32)(handle->startTime + BME280_STATUS_MINIMUM_WAIT - Clock_getTicks());
+	remaining = _bme280_remaining(deadline) - BME280_DEADLINE_RESERVE;  // Leave time for the first poll
+	if (wait > remaining) {
+		wait = remaining;
+	}
+	if (wait > 0) {
+		Task_sleep(wait);
+	}
+}
+
+/// @brief Poll STATUS until the conversion completes, then read all measurements into <out>
+BME280_Result BME280_readMeasurementsUntil(Uint32 deadline, BME280_RawData *out)
+{
+	return BME280_Handle_readMeasurementsUntil(&_bme280_default, deadline, out);
+}
+
+/// @brief Poll STATUS until the conversion completes, then read all measurements into <out>
+/// @details Like BME280_readMeasurements(), but every sleep is clipped so that BME280_DEADLINE_RESERVE ticks
+///          remain before <deadline> for the final STATUS poll and the data read.
+BME280_Result BME280_Handle_readMeasurementsUntil(BME280_Handle handle, Uint32 deadline, BME280_RawData *out)
+{
+	Uint32 status_delay = BME280_STATUS_MINIMUM_WAIT;
+	Int32 remaining;
+	BME280_Result res;
+	Uint8 stat;
+
+	if (!handle->opened) {
+		return BME280_RESULT_NOT_OPEN;
+	}
+	if (!handle->pending) {
+		return BME280_RESULT_NO_DATA;  // Registers hold a conversion that was already handed out (or none at all)
+	}
+
+	while (1) {
+		res = _bme280_readRegs(handle, BME280_REG_STATUS, &stat, 1, true, deadline);
+		if (res != BME280_RESULT_OK) {
+			return res;
+		}
+		if (!(stat & (BME280_STATUS_MEASURING | BME280_STATUS_IM_UPDATE))) {
+			break;
+		}
+		remaining = _bme280_remaining(deadline) - BME280_DEADLINE_RESERVE;
+		if (remaining <= 0) {
+			return BME280_RESULT_TIMEOUT;
+		}
+		if (status_delay > (Uint32)remaining) {
+			status_delay = remaining;
+		}
+		Task_sleep(status_delay);
+		if (status_delay < 32768) {
+			status_delay <<= 1;  // Double the poll time
+		}
+	}
+
+	res = _bme280_fetch(handle, out, true, deadline);
+	if (res == BME280_RESULT_OK) {
+		handle->pending = false;
+	}
+	return res;
+}
+
+/// @brief Initiate a Forced measurement, poll to completion and read it, all before <deadline>
+BME280_Result BME280_readUntil(Uint32 deadline, BME280_RawData *out)
+{
+	return BME280_Handle_readUntil(&_bme280_default, deadline, out);
+}
+
+/// @brief Initiate a Forced measurement, poll to completion and read it, all before <deadline>
+BME280_Result BME280_Handle_readUntil(BME280_Handle handle, Uint32 deadline, BME280_RawData *out)
+{
+	BME280_Result res;
+
+	res = BME280_Handle_start(handle, deadline);
+	if (res != BME280_RESULT_OK) {
+		return res;
+	}
+	BME280_Handle_waitConversion(handle, deadline);
+	return BME280_Handle_readMeasurementsUntil(handle, deadline, out);
 }
 
 /// @brief Initiate a Forced measurement, poll to completion, read & return raw data
 /// @details By default after BME280_open(), measurement is 4x oversampling, no IIR filter on Pressure.
+///          Gives up after BME280_READ_TIMEOUT ticks; returns NULL on any failure rather than stale data.
 BME280_RawData * BME280_read()
 {
-	BME280_writeReg(BME280_REG_CTRL_MEAS, BME280_CTRL_MEAS_MODE_FORCED | _bme280_ctrl_meas);
-	Task_sleep(BME280_STATUS_MINIMUM_WAIT);
-
-	return BME280_readMeasurements(0);
+	if (BME280_readUntil(Clock_getTicks() + BME280_READ_TIMEOUT, &_rawData) != BME280_RESULT_OK) {
+		return NULL;
+	}
+	return &_rawData;
 }
 
 /* Calibration positions */
@@ -291,24 +637,24 @@ BME280_RawData * BME280_read()
 #define BME280_CALIBOFFSET_S16LE_dig_H5          30
 #define BME280_CALIBOFFSET_S8_dig_H6             32
 
-#define BME280_dig_T1 ( _bme280_compute_U16LE(_bme280_calibration[BME280_CALIBOFFSET_U16LE_dig_T1], _bme280_calibration[BME280_CALIBOFFSET_U16LE_dig_T1+1]) )
-#define BME280_dig_T2 ( _bme280_compute_S16LE(_bme280_calibration[BME280_CALIBOFFSET_S16LE_dig_T2], _bme280_calibration[BME280_CALIBOFFSET_S16LE_dig_T2+1]) )
-#define BME280_dig_T3 ( _bme280_compute_S16LE(_bme280_calibration[BME280_CALIBOFFSET_S16LE_dig_T3], _bme280_calibration[BME280_CALIBOFFSET_S16LE_dig_T3+1]) )
-#define BME280_dig_P1 ( _bme280_compute_U16LE(_bme280_calibration[BME280_CALIBOFFSET_U16LE_dig_P1], _bme280_calibration[BME280_CALIBOFFSET_U16LE_dig_P1+1]) )
-#define BME280_dig_P2 ( _bme280_compute_S16LE(_bme280_calibration[BME280_CALIBOFFSET_S16LE_dig_P2], _bme280_calibration[BME280_CALIBOFFSET_S16LE_dig_P2+1]) )
-#define BME280_dig_P3 ( _bme280_compute_S16LE(_bme280_calibration[BME280_CALIBOFFSET_S16LE_dig_P3], _bme280_calibration[BME280_CALIBOFFSET_S16LE_dig_P3+1]) )
-#define BME280_dig_P4 ( _bme280_compute_S16LE(_bme280_calibration[BME280_CALIBOFFSET_S16LE_dig_P4], _bme280_calibration[BME280_CALIBOFFSET_S16LE_dig_P4+1]) )
-#define BME280_dig_P5 ( _bme280_compute_S16LE(_bme280_calibration[BME280_CALIBOFFSET_S16LE_dig_P5], _bme280_calibration[BME280_CALIBOFFSET_S16LE_dig_P5+1]) )
-#define BME280_dig_P6 ( _bme280_compute_S16LE(_bme280_calibration[BME280_CALIBOFFSET_S16LE_dig_P6], _bme280_calibration[BME280_CALIBOFFSET_S16LE_dig_P6+1]) )
-#define BME280_dig_P7 ( _bme280_compute_S16LE(_bme280_calibration[BME280_CALIBOFFSET_S16LE_dig_P7], _bme280_calibration[BME280_CALIBOFFSET_S16LE_dig_P7+1]) )
-#define BME280_dig_P8 ( _bme280_compute_S16LE(_bme280_calibration[BME280_CALIBOFFSET_S16LE_dig_P8], _bme280_calibration[BME280_CALIBOFFSET_S16LE_dig_P8+1]) )
-#define BME280_dig_P9 ( _bme280_compute_S16LE(_bme280_calibration[BME280_CALIBOFFSET_S16LE_dig_P9], _bme280_calibration[BME280_CALIBOFFSET_S16LE_dig_P9+1]) )
-#define BME280_dig_H1 ( (Uint8)_bme280_calibration[BME280_CALIBOFFSET_U8_dig_H1] )
-#define BME280_dig_H2 ( _bme280_compute_S16LE(_bme280_calibration[BME280_CALIBOFFSET_S16LE_dig_H2], _bme280_calibration[BME280_CALIBOFFSET_S16LE_dig_H2+1]) )
-#define BME280_dig_H3 ( (Uint8)_bme280_calibration[BME280_CALIBOFFSET_U8_dig_H3] )
-#define BME280_dig_H4 ( _bme280_compute_H4(_bme280_calibration[BME280_CALIBOFFSET_S16LE_dig_H4], _bme280_calibration[BME280_CALIBOFFSET_S16LE_dig_H4+1]) )
-#define BME280_dig_H5 ( _bme280_compute_H5(_bme280_calibration[BME280_CALIBOFFSET_S16LE_dig_H5], _bme280_calibration[BME280_CALIBOFFSET_S16LE_dig_H5+1]) )
-#define BME280_dig_H6 ( (Int8)_bme280_calibration[BME280_CALIBOFFSET_S8_dig_H6] )
+#define BME280_dig_T1 ( _bme280_compute_U16LE(cal[BME280_CALIBOFFSET_U16LE_dig_T1], cal[BME280_CALIBOFFSET_U16LE_dig_T1+1]) )
+#define BME280_dig_T2 ( _bme280_compute_S16LE(cal[BME280_CALIBOFFSET_S16LE_dig_T2], cal[BME280_CALIBOFFSET_S16LE_dig_T2+1]) )
+#define BME280_dig_T3 ( _bme280_compute_S16LE(cal[BME280_CALIBOFFSET_S16LE_dig_T3], cal[BME280_CALIBOFFSET_S16LE_dig_T3+1]) )
+#define BME280_dig_P1 ( _bme280_compute_U16LE(cal[BME280_CALIBOFFSET_U16LE_dig_P1], cal[BME280_CALIBOFFSET_U16LE_dig_P1+1]) )
+#define BME280_dig_P2 ( _bme280_compute_S16LE(cal[BME280_CALIBOFFSET_S16LE_dig_P2], cal[BME280_CALIBOFFSET_S16LE_dig_P2+1]) )
+#define BME280_dig_P3 ( _bme280_compute_S16LE(cal[BME280_CALIBOFFSET_S16LE_dig_P3], cal[BME280_CALIBOFFSET_S16LE_dig_P3+1]) )
+#define BME280_dig_P4 ( _bme280_compute_S16LE(cal[BME280_CALIBOFFSET_S16LE_dig_P4], cal[BME280_CALIBOFFSET_S16LE_dig_P4+1]) )
+#define BME280_dig_P5 ( _bme280_compute_S16LE(cal[BME280_CALIBOFFSET_S16LE_dig_P5], cal[BME280_CALIBOFFSET_S16LE_dig_P5+1]) )
+#define BME280_dig_P6 ( _bme280_compute_S16LE(cal[BME280_CALIBOFFSET_S16LE_dig_P6], cal[BME280_CALIBOFFSET_S16LE_dig_P6+1]) )
+#define BME280_dig_P7 ( _bme280_compute_S16LE(cal[BME280_CALIBOFFSET_S16LE_dig_P7], cal[BME280_CALIBOFFSET_S16LE_dig_P7+1]) )
+#define BME280_dig_P8 ( _bme280_compute_S16LE(cal[BME280_CALIBOFFSET_S16LE_dig_P8], cal[BME280_CALIBOFFSET_S16LE_dig_P8+1]) )
+#define BME280_dig_P9 ( _bme280_compute_S16LE(cal[BME280_CALIBOFFSET_S16LE_dig_P9], cal[BME280_CALIBOFFSET_S16LE_dig_P9+1]) )
+#define BME280_dig_H1 ( (Uint8)cal[BME280_CALIBOFFSET_U8_dig_H1] )
+#define BME280_dig_H2 ( _bme280_compute_S16LE(cal[BME280_CALIBOFFSET_S16LE_dig_H2], cal[BME280_CALIBOFFSET_S16LE_dig_H2+1]) )
+#define BME280_dig_H3 ( (Uint8)cal[BME280_CALIBOFFSET_U8_dig_H3] )
+#define BME280_dig_H4 ( _bme280_compute_H4(cal[BME280_CALIBOFFSET_S16LE_dig_H4], cal[BME280_CALIBOFFSET_S16LE_dig_H4+1]) )
+#define BME280_dig_H5 ( _bme280_compute_H5(cal[BME280_CALIBOFFSET_S16LE_dig_H5], cal[BME280_CALIBOFFSET_S16LE_dig_H5+1]) )
+#define BME280_dig_H6 ( (Int8)cal[BME280_CALIBOFFSET_S8_dig_H6] )
 
 inline Int16 _bme280_compute_S16LE(Uint8 r0, Uint8 r1)
 {
@@ -347,14 +693,20 @@ inline Int16 _bme280_compute_H5(Uint8 e5, Uint8 e6)
 }
 
 /* These compensation equations are derived from BME280 datasheet pseudocode, page 23 & 24 */
-static Int32 _t_fine;
 
 /// @brief Compute Temperature from BME280_RawData struct
 /// @details Output degrees Celsius with 0.01C resolution.  Divide by 100 for whole degrees.
 ///          This function needs to be run before computing Pressure or Humidity to compute
-///          the _t_fine constant used by the Pressure and Humidity compensation functions below.
+///          the t_fine constant used by the Pressure and Humidity compensation functions below.
 Int32 BME280_compensated_Temperature(BME280_RawData *rd)
 {
+	return BME280_Handle_compensated_Temperature(&_bme280_default, rd);
+}
+
+Int32 BME280_Handle_compensated_Temperature(BME280_Handle handle, BME280_RawData *rd)
+{
+	const Uint8 *cal = handle->calibration;
+
 	if (rd == NULL) {
 		return -32768;
 	}
@@ -364,8 +716,8 @@ Int32 BME280_compensated_Temperature(BME280_RawData *rd)
 
 	var1 = ((((adc_T >> 3) - ((Int32)BME280_dig_T1 << 1))) * ((Int32)BME280_dig_T2)) >> 11;
 	var2 = (((((adc_T >> 4) - (Int32)BME280_dig_T1) * ((adc_T >> 4) - (Int32)BME280_dig_T1)) >> 12) * (Int32)BME280_dig_T3) >> 14;
-	_t_fine = var1 + var2;
-	T = (_t_fine * 5 + 128) >> 8;
+	handle->t_fine = var1 + var2;
+	T = (handle->t_fine * 5 + 128) >> 8;
 
 	return T;
 }
@@ -374,13 +726,20 @@ Int32 BME280_compensated_Temperature(BME280_RawData *rd)
 /// @details Pressure in Pascals as unsigned 32-bit integer in Q24.8 format; divide by 256 for whole Pascals
 Uint32 BME280_compensated_Pressure(BME280_RawData *rd)
 {
+	return BME280_Handle_compensated_Pressure(&_bme280_default, rd);
+}
+
+Uint32 BME280_Handle_compensated_Pressure(BME280_Handle handle, BME280_RawData *rd)
+{
+	const Uint8 *cal = handle->calibration;
+
 	if (rd == NULL) {
 		return 0;
 	}
 	Int32 adc_P = rd->pressure_raw; // No sign extension will be performed as the raw value is expected to be positive.
 
 	Int64 var1, var2, p;
-	var1 = (Int64)_t_fine - 128000;
+	var1 = (Int64)handle->t_fine - 128000;
 	var2 = var1 * var1 * (Int64)BME280_dig_P6;
 	var2 = var2 + ((var1 * (Int64)BME280_dig_P5) << 17);
 	var2 = var2 + (((Int64)BME280_dig_P3) >> 8) + ((var1 * (Int64)BME280_dig_P2) << 12);
@@ -401,13 +760,20 @@ Uint32 BME280_compensated_Pressure(BME280_RawData *rd)
 /// @details Humidity in %relativehumidity as unsigned 32-bit integer in Q22.10 format; divide by 1024 for whole %RH
 Uint32 BME280_compensated_Humidity(BME280_RawData *rd)
 {
+	return BME280_Handle_compensated_Humidity(&_bme280_default, rd);
+}
+
+Uint32 BME280_Handle_compensated_Humidity(BME280_Handle handle, BME280_RawData *rd)
+{
+	const Uint8 *cal = handle->calibration;
+
 	if (rd == NULL) {
 		return 0;
 	}
 	Int32 adc_H = (Uint32)rd->humidity_raw; // No sign extension will be performed as the raw value is expected to be positive.
 
 	Int32 v_x1_u32r;
-	v_x1_u32r = _t_fine - ((Int32)76800);
+	v_x1_u32r = handle->t_fine - ((Int32)76800);
 	v_x1_u32r = (((((adc_H << 14) - (((Int32)BME280_dig_H4) << 20) - (((Int32)BME280_dig_H5) * v_x1_u32r)) \
 			+ ((Int32)16384)) >> 15) * (((((((v_x1_u32r * ((Int32)BME280_dig_H6)) >> 10) \
 			* (((v_x1_u32r * ((Int32)BME280_dig_H3)) >> 11) + ((Int32)32768))) >> 10) + ((Int32)2097152)) \
@@ -49,6 +49,29 @@
 /// @details If this is defined, BME280_open() will report detailed errors using System_printf() for why
 ///          it failed to open.
 #define BME280_DEBUG_OPEN 1
+/// @details If this is defined, every failed I2C_transfer() is reported using System_printf() along with
+///          the register address and attempt number.  Off by default: console output can take far longer than
+///          any deadline passed to the deadline-bounded API.
+//#define BME280_DEBUG_TRANSFER 1
+/// @details Define this if the TI-RTOS I2C driver implements I2C_cancel().  It enables callback mode (see the
+///          deadline-bounded API below); without it the driver only ever calls I2C_transfer() in blocking mode.
+//#define BME280_I2C_HAS_CANCEL 1
+
+/// @brief Number of additional attempts made for a failed I2C transfer before reporting a bus error
+#define BME280_I2C_RETRIES 2
+/// @brief Ticks to wait after bus recovery before retrying a failed I2C transfer
+#define BME280_I2C_RETRY_WAIT 1
+/// @brief Ticks a cancelled transfer is given to call back (callback mode only); adds to the deadline bound
+#define BME280_I2C_CANCEL_WAIT 1
+/// @brief Ticks kept free before the deadline for the final STATUS poll and data read
+#define BME280_DEADLINE_RESERVE 2
+
+/// @brief Timeout (ticks) used by BME280_read()
+/// @details A Forced measurement with 16x oversampling on all three channels takes at most ~113ms per the datasheet.
+#define BME280_READ_TIMEOUT 250
+
+/// @brief Raw 20-bit value present in the PRESS/TEMP registers after reset or when the measurement was skipped
+#define BME280_RAW_NODATA 0x80000
 
 /* Data types */
 /// @brief Holds raw register values for measurements
@@ -62,11 +85,53 @@ typedef struct {
 	Uint32 pressure_raw;
 } BME280_RawData;
 
+/// @brief Result codes returned by the deadline-bounded API
+typedef enum {
+	BME280_RESULT_OK = 0,     ///< A fresh measurement was stored in the caller's buffer
+	BME280_RESULT_NOT_OPEN,   ///< BME280_open() has not completed successfully
+	BME280_RESULT_BUS_ERROR,  ///< An I2C transfer still failed after BME280_I2C_RETRIES retries
+	BME280_RESULT_TIMEOUT,    ///< The deadline passed before the measurement completed
+	BME280_RESULT_NO_DATA     ///< No fresh conversion to read: none was started, it was already read, or the registers hold their reset value
+} BME280_Result;
+
+/// @brief Per-sensor driver state
+/// @details One of these exists for every BME280 in the system; the handle-less API uses an internal default
+///          instance.  An instance must only be used from one Task at a time, so put all sensors sharing an
+///          I2C bus in the same Task (see bme280_acq.h).
+typedef struct {
+	I2C_Handle i2cbus;        ///< I2C bus the sensor is attached to
+	Uint8 i2cAddr;            ///< I2C slave address of the sensor
+	Uint8 calibration[33];    ///< Unique calibration values read during BME280_Handle_open()
+	Uint8 ctrl_meas;          ///< CTRL_MEAS OSRS settings, preserved when modifying CTRL_MEAS:mode[]
+	Bool opened;              ///< Set once calibration has been read successfully
+	Bool pending;             ///< Set by BME280_Handle_start(), cleared once that conversion has been read out
+	Uint32 startTime;         ///< Clock_getTicks() when the pending conversion was triggered
+	Int32 t_fine;             ///< Temperature term shared by the compensation functions
+	Uint32 busyTime;          ///< Timestamp_get32() units spent on I2C transfers, wraps silently
+	#ifdef BME280_I2C_HAS_CANCEL
+	Bool callbackMode;        ///< See BME280_Handle_setCallbackMode()
+	Semaphore_Struct txnDone; ///< Posted by BME280_transferCallback()
+	Bool txnStatus;           ///< Transfer result reported by BME280_transferCallback()
+	Bool txnInFlight;         ///< A cancelled transfer has not called back yet
+	#endif
+	I2C_Transaction txn;      ///< Transfers use instance-owned storage so a late completion can't hit a dead stack frame
+	Uint8 txBuf[2];
+	Uint8 rxBuf[26];
+} BME280_Object;
+
+/// @brief Handle to a driver instance, returned by BME280_construct()
+typedef BME280_Object *BME280_Handle;
+
+/// @brief Optional bus recovery hook
+/// @details Called with the I2C_Handle before each retry of a failed transfer, e.g. to clock out a slave
+///          holding SDA low via GPIO.  Must return within a few ticks, as it counts against the caller's deadline.
+typedef Void (*BME280_BusRecoveryFxn)(I2C_Handle);
+
 /* Basic API */
 Void BME280_init(I2C_Handle, Uint8 slaveaddr); /// @brief Driver initialization
 Bool BME280_open();                            /// @brief Make contact with the chip and read calibration registers
 Bool BME280_close();                           /// @brief Reset chip
-BME280_RawData *BME280_read();                 /// @brief Initiate a Forced measurement, poll to completion, read & return raw data
+BME280_RawData *BME280_read();                 /// @brief Initiate a Forced measurement, poll to completion, read & return raw data (NULL on failure or after BME280_READ_TIMEOUT)
 /// @brief Collect current data
 /// @details This will first poll the STATUS register to ascertain no measurements are in progress; if they are, it
 ///          will perform Task_sleep() and poll again.  Since this uses Task_sleep(), this function must ALWAYS
@@ -77,6 +142,66 @@ BME280_RawData *BME280_read();                 /// @brief Initiate a Forced meas
 #define BME280_STATUS_MINIMUM_WAIT 8
 BME280_RawData *BME280_readMeasurements(Uint16 timeout);
 
+/* Deadline-bounded API
+ * How hard the deadline is depends on how the I2C_Handle was opened:
+ *  - I2C_MODE_CALLBACK with transferCallbackFxn = BME280_transferCallback, and BME280_setCallbackMode(true):
+ *    each transfer is waited for with Semaphore_pend() up to the deadline, then I2C_cancel()ed.  Calls return
+ *    no later than <deadline> + BME280_I2C_CANCEL_WAIT ticks (plus the runtime of any bus recovery hook).
+ *    Only available with BME280_I2C_HAS_CANCEL defined, as it requires an I2C driver that implements I2C_cancel().
+ *    The callback belongs to the I2C_Handle, so such a bus must only be used by BME280 instances.
+ *  - I2C_MODE_BLOCKING: no transfer is started after <deadline>, but one that has started cannot be interrupted.
+ *    Calls return no later than <deadline> plus the duration of one transfer, which is unbounded if a slave
+ *    stretches SCL or holds SDA low.
+ */
+
+#ifdef BME280_I2C_HAS_CANCEL
+/// @brief I2C callback to install as I2C_Params.transferCallbackFxn for callback mode
+Void BME280_transferCallback(I2C_Handle hand, I2C_Transaction *txn, bool status);
+/// @brief Declare that the default instance's I2C_Handle was opened in callback mode (see above)
+Void BME280_setCallbackMode(Bool enable);
+#endif
+
+/// @brief Install (or clear with NULL) the bus recovery hook used between transfer retries
+Void BME280_setBusRecoveryFxn(BME280_BusRecoveryFxn fxn);
+/// @brief Initiate a Forced measurement without waiting for it
+/// @details Every I2C transfer is checked and retried; nothing is attempted once <deadline> (absolute
+///          Clock_getTicks() value) has passed.
+BME280_Result BME280_start(Uint32 deadline);
+/// @brief Sleep until the conversion started by BME280_start() has run for <BME280_STATUS_MINIMUM_WAIT> ticks
+/// @details Gives the conversion a head start before the first STATUS poll.  Never sleeps into the last
+///          BME280_DEADLINE_RESERVE ticks before <deadline>, and returns at once if no conversion is pending
+///          or it has already run long enough.
+Void BME280_waitConversion(Uint32 deadline);
+/// @brief Poll STATUS until the conversion completes, then read all measurements into <out>
+/// @details STATUS polling sleeps as BME280_readMeasurements() does, but each sleep is clipped so that
+///          BME280_DEADLINE_RESERVE ticks remain for the last poll and the data read.  See above for the bound.
+///          <out> is only written when BME280_RESULT_OK is returned; it never receives stale or partial data.
+///          Each BME280_start() allows exactly one successful read; without one, BME280_RESULT_NO_DATA is returned.
+BME280_Result BME280_readMeasurementsUntil(Uint32 deadline, BME280_RawData *out);
+/// @brief Initiate a Forced measurement, poll to completion and read it, all before <deadline>
+/// @details Equivalent to BME280_start(), BME280_waitConversion() and BME280_readMeasurementsUntil().  Must run in Task context.
+BME280_Result BME280_readUntil(Uint32 deadline, BME280_RawData *out);
+
+/* Instance API
+ * Same behavior as the handle-less functions of the same name, applied to a caller-owned BME280_Object.
+ */
+/// @brief Initialize a driver instance for the sensor at <addr> on <hand>; no bus traffic takes place
+/// @details With BME280_I2C_HAS_CANCEL this constructs a Semaphore inside <obj>, so call it once per object.
+BME280_Handle BME280_construct(BME280_Object *obj, I2C_Handle hand, Uint8 addr);
+#ifdef BME280_I2C_HAS_CANCEL
+Void BME280_Handle_setCallbackMode(BME280_Handle handle, Bool enable);
+#endif
+Bool BME280_Handle_open(BME280_Handle handle);
+Bool BME280_Handle_close(BME280_Handle handle);
+Uint8 BME280_Handle_readReg(BME280_Handle handle, Uint8 memAddress);
+BME280_Result BME280_Handle_start(BME280_Handle handle, Uint32 deadline);
+Void BME280_Handle_waitConversion(BME280_Handle handle, Uint32 deadline);
+BME280_Result BME280_Handle_readMeasurementsUntil(BME280_Handle handle, Uint32 deadline, BME280_RawData *out);
+BME280_Result BME280_Handle_readUntil(BME280_Handle handle, Uint32 deadline, BME280_RawData *out);
+Int32 BME280_Handle_compensated_Temperature(BME280_Handle handle, BME280_RawData *);
+Uint32 BME280_Handle_compensated_Pressure(BME280_Handle handle, BME280_RawData *);
+Uint32 BME280_Handle_compensated_Humidity(BME280_Handle handle, BME280_RawData *);
+
 /* Numeric interpretation/compensation API for extracting results */
 
 /// @brief Compute Temperature from BME280_RawData struct
@@ -0,0 +1,253 @@
+/*
+ * @file bme280_acq.c
+ * @brief BME280 Multi-bus Acquisition Engine Code
+ * @headerfile <bme280_acq.h>
+ * @details Periodic acquisition of many BME280 sensors spread over several I2C buses, one Task per bus,
+ *          merged into a single time-ordered stream of samples.
+ *
+ * @author bme280_tirtos contributors
+ * @date 2026
+ * @copyright (C) 2026 bme280_tirtos contributors
+ *  @n Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+ *  @n (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge,
+ *  @n publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to
+ *  @n do so, subject to the following conditions:
+ *  @n
+ *  @n The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *  @n
+ *  @n THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  @n OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ *  @n BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ *  @n OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *  @n
+ *  @n A copy of the BME280 product datasheet may be found on BOSCH SENSORTEC's product page:
+ *  @n https://www.bosch-sensortec.com/bst/products/all_products/bme280
+ */
+
+#include <string.h>
+
+/* XDCtools Header files */
+#include <xdc/std.h>
+#include <xdc/runtime/System.h>
+#include <xdc/runtime/Error.h>
+#include <xdc/runtime/Timestamp.h>
+
+/* BIOS Header files */
+#include <ti/sysbios/BIOS.h>
+#include <ti/sysbios/knl/Task.h>
+#include <ti/sysbios/knl/Clock.h>
+#include <ti/sysbios/knl/Mailbox.h>
+#include <ti/sysbios/gates/GateMutex.h>
+
+#include "bme280.h"
+#include "bme280_acq.h"
+
+/// @brief Sensors and bookkeeping owned by one worker Task
+typedef struct {
+	BME280_Handle sensors[BME280_ACQ_MAX_SENSORS_PER_BUS];
+	Uint8 sensorIds[BME280_ACQ_MAX_SENSORS_PER_BUS];
+	Uint8 numSensors;
+	BME280_Acq_BusStats stats;  ///< Protected by _acq_gate
+	Task_Handle task;
+} BME280_Acq_Bus;
+
+static BME280_Acq_Bus _acq_buses[BME280_ACQ_MAX_BUSES];
+static Mailbox_Handle _acq_stream;  /// @brief Merged sample stream, non-NULL once BME280_Acq_start() succeeded
+static GateMutex_Handle _acq_gate;  /// @brief Serializes timestamping + posting, and access to the stats
+static Uint32 _acq_period;
+
+/// @brief Timestamp and post a sample to the merged stream
+/// @details The timestamp is the posting time, see BME280_Acq_Sample.
+static Void _bme280_acq_publish(BME280_Acq_Bus *bus, BME280_Acq_Sample *sample)
+{
+	IArg key;
+
+	key = GateMutex_enter(_acq_gate);
+	sample->timestamp = Clock_getTicks();  // Taken under the gate so the stream stays in timestamp order
+	if (!Mailbox_post(_acq_stream, sample, BIOS_NO_WAIT)) {
+		bus->stats.dropped++;
+	} else if (sample->result == BME280_RESULT_OK) {
+		bus->stats.samples++;
+	} else {
+		bus->stats.errors++;
+	}
+	GateMutex_leave(_acq_gate, key);
+}
+
+/// @brief Total I2C busy time of all sensors on <bus>, in Timestamp_get32() units (wraps)
+static Uint32 _bme280_acq_busyTime(BME280_Acq_Bus *bus)
+{
+	Uint32 busy = 0;
+	Uint8 i;
+
+	for (i = 0; i < bus->numSensors; i++) {
+		busy += bus->sensors[i]->busyTime;
+	}
+	return busy;
+}
+
+/// @brief Worker Task; arg0 is the bus index
+static Void _bme280_acq_worker(UArg arg0, UArg arg1)
+{
+	BME280_Acq_Bus *bus = &_acq_buses[arg0];
+	BME280_Result res[BME280_ACQ_MAX_SENSORS_PER_BUS];
+	BME280_Acq_Sample sample;
+	BME280_Handle sensor;
+	Uint32 deadline = Clock_getTicks();
+	Uint32 t0 = Timestamp_get32(), t1;
+	Uint32 busy0, busy1;
+	Int32 remaining;
+	IArg key;
+	Uint8 first = 0, i, n;
+
+	while (1) {
+		deadline += _acq_period;
+		busy0 = _bme280_acq_busyTime(bus);
+
+		// Trigger every sensor first so their conversions overlap; the bus is only held for the short transfers.
+		// Both passes start at sensor <first>, which rotates every cycle: when the bus overruns its period the
+		// sensors read last time out, and that must not always be the same ones.
+		for (i = 0; i < bus->numSensors; i++) {
+			n = (first + i) % bus->numSensors;
+			res[n] = BME280_Handle_start(bus->sensors[n], deadline);
+		}
+
+		for (i = 0; i < bus->numSensors; i++) {
+			n = (first + i) % bus->numSensors;
+			sensor = bus->sensors[n];
+			memset(&sample, 0, sizeof(sample));  // An error sample must not carry the previous sensor's readings
+			sample.sensorId = bus->sensorIds[n];
+			sample.bus = (Uint8)arg0;
+			sample.result = res[n];
+			if (sample.result == BME280_RESULT_OK) {
+				BME280_Handle_waitConversion(sensor, deadline);  // Only sleeps for the first sensor started
+				sample.result = BME280_Handle_readMeasurementsUntil(sensor, deadline, &sample.raw);
+			}
+			if (sample.result == BME280_RESULT_OK) {
+				sample.temperature = BME280_Handle_compensated_Temperature(sensor, &sample.raw);
+				sample.pressure = BME280_Handle_compensated_Pressure(sensor, &sample.raw);
+				sample.humidity = BME280_Handle_compensated_Humidity(sensor, &sample.raw);
+			}
+			_bme280_acq_publish(bus, &sample);
+		}
+		busy1 = _bme280_acq_busyTime(bus);
+		first = (first + 1) % bus->numSensors;
+
+		// Idle until the next period; after an overrun, restart the schedule instead of bursting to catch up
+		remaining = (Int32)(deadline - Clock_getTicks());
+		if (remaining > 0) {
+			Task_sleep(remaining);
+		} else {
+			deadline = Clock_getTicks();
+		}
+
+		t1 = Timestamp_get32();
+		key = GateMutex_enter(_acq_gate);
+		bus->stats.cycles++;
+		bus->stats.busyTime += busy1 - busy0;
+		bus->stats.elapsedTime += t1 - t0;
+		GateMutex_leave(_acq_gate, key);
+		t0 = t1;
+	}
+}
+
+/// @brief Attach an opened sensor to <bus>
+Bool BME280_Acq_addSensor(Uint8 bus, BME280_Handle sensor, Uint8 sensorId)
+{
+	BME280_Acq_Bus *b;
+
+	if (_acq_stream != NULL || bus >= BME280_ACQ_MAX_BUSES) {
+		return false;
+	}
+	b = &_acq_buses[bus];
+	if (b->numSensors >= BME280_ACQ_MAX_SENSORS_PER_BUS) {
+		return false;
+	}
+	b->sensors[b->numSensors] = sensor;
+	b->sensorIds[b->numSensors] = sensorId;
+	b->numSensors++;
+	return true;
+}
+
+/// @brief Create the merged stream and one worker Task per bus that has sensors
+/// @details The scheduler is held off while the workers are created so that either all of them start or,
+///          on failure, none has run and they can all be deleted again.
+Bool BME280_Acq_start(Uint32 period)
+{
+	Error_Block eb;
+	Task_Params taskParams;
+	UInt key;
+	Uint8 b;
+
+	if (_acq_stream != NULL || period == 0) {
+		return false;
+	}
+
+	Error_init(&eb);
+	_acq_gate = GateMutex_create(NULL, &eb);
+	if (_acq_gate == NULL) {
+		return false;
+	}
+	_acq_stream = Mailbox_create(sizeof(BME280_Acq_Sample), BME280_ACQ_QUEUE_DEPTH, NULL, &eb);
+	if (_acq_stream == NULL) {
+		GateMutex_delete(&_acq_gate);
+		return false;
+	}
+	_acq_period = period;
+
+	key = Task_disable();
+	for (b = 0; b < BME280_ACQ_MAX_BUSES; b++) {
+		if (_acq_buses[b].numSensors == 0) {
+			continue;
+		}
+		Task_Params_init(&taskParams);
+		taskParams.arg0 = b;
+		taskParams.stackSize = BME280_ACQ_TASK_STACKSIZE;
+		taskParams.priority = BME280_ACQ_TASK_PRIORITY;
+		_acq_buses[b].task = Task_create(_bme280_acq_worker, &taskParams, &eb);
+		if (_acq_buses[b].task == NULL) {
+			System_printf("Error: BME280_Acq_start() could not create worker for bus %u\r\n", b);
+			System_flush();
+			while (b-- > 0) {
+				if (_acq_buses[b].task != NULL) {
+					Task_delete(&_acq_buses[b].task);
+				}
+			}
+			Mailbox_delete(&_acq_stream);
+			GateMutex_delete(&_acq_gate);
+			Task_restore(key);
+			return false;
+		}
+	}
+	Task_restore(key);
+
+	return true;
+}
+
+/// @brief Receive the next sample of the merged stream
+Bool BME280_Acq_pend(BME280_Acq_Sample *sample, UInt timeout)
+{
+	if (_acq_stream == NULL) {
+		return false;
+	}
+	return Mailbox_pend(_acq_stream, sample, timeout);
+}
+
+/// @brief Snapshot the counters for <bus>
+Bool BME280_Acq_getBusStats(Uint8 bus, BME280_Acq_BusStats *stats)
+{
+	IArg key;
+
+	if (bus >= BME280_ACQ_MAX_BUSES) {
+		return false;
+	}
+	if (_acq_gate != NULL) {
+		key = GateMutex_enter(_acq_gate);
+		*stats = _acq_buses[bus].stats;
+		GateMutex_leave(_acq_gate, key);
+	} else {
+		*stats = _acq_buses[bus].stats;
+	}
+	stats->utilization = stats->elapsedTime ? (Uint16)((stats->busyTime * 1000) / stats->elapsedTime) : 0;
+	return true;
+}
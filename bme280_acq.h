@@ -0,0 +1,89 @@
+/*
+ * @file bme280_acq.h
+ * @brief BME280 Multi-bus Acquisition Engine Header
+ * @headerfile <>
+ * @details Periodic acquisition of many BME280 sensors spread over several I2C buses, one Task per bus,
+ *          merged into a single time-ordered stream of samples.
+ *
+ * @author bme280_tirtos contributors
+ * @date 2026
+ * @copyright (C) 2026 bme280_tirtos contributors
+ *  @n Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+ *  @n (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge,
+ *  @n publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to
+ *  @n do so, subject to the following conditions:
+ *  @n
+ *  @n The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *  @n
+ *  @n THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  @n OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ *  @n BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ *  @n OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *  @n
+ *  @n A copy of the BME280 product datasheet may be found on BOSCH SENSORTEC's product page:
+ *  @n https://www.bosch-sensortec.com/bst/products/all_products/bme280
+ */
+
+#ifndef BME280_ACQ_H_
+#define BME280_ACQ_H_
+
+#include "bme280.h"
+
+/// @brief Number of buses the engine can drive, each getting its own worker Task
+#define BME280_ACQ_MAX_BUSES 4
+/// @brief Number of sensors that can be attached to a single bus
+#define BME280_ACQ_MAX_SENSORS_PER_BUS 4
+/// @brief Depth of the merged sample stream; samples arriving while it is full are counted as dropped
+#define BME280_ACQ_QUEUE_DEPTH 32
+/// @brief Worker Task parameters
+#define BME280_ACQ_TASK_STACKSIZE 1024
+#define BME280_ACQ_TASK_PRIORITY 2
+
+/// @brief One entry of the merged stream
+/// @details <timestamp> is the time the sample was posted to the stream, not the time it was read out of
+///          the sensor: it is taken while holding the stream's gate, so samples are always received in
+///          non-decreasing timestamp order regardless of which bus produced them.  It lags the readout by
+///          the compensation time plus any wait for the gate.
+typedef struct {
+	Uint32 timestamp;       ///< Clock_getTicks() when the sample was posted to the stream
+	Uint8 sensorId;         ///< ID given to BME280_Acq_addSensor()
+	Uint8 bus;              ///< Bus index given to BME280_Acq_addSensor()
+	BME280_Result result;   ///< The fields below are only valid if this is BME280_RESULT_OK
+	BME280_RawData raw;
+	Int32 temperature;      ///< As returned by BME280_compensated_Temperature()
+	Uint32 pressure;        ///< As returned by BME280_compensated_Pressure()
+	Uint32 humidity;        ///< As returned by BME280_compensated_Humidity()
+} BME280_Acq_Sample;
+
+/// @brief Per-bus counters, see BME280_Acq_getBusStats()
+typedef struct {
+	Uint32 cycles;          ///< Acquisition periods completed
+	Uint32 samples;         ///< Samples posted with BME280_RESULT_OK
+	Uint32 errors;          ///< Samples posted with any other result
+	Uint32 dropped;         ///< Samples lost because the stream was full
+	Uint64 busyTime;        ///< Timestamp_get32() units spent inside I2C_transfer()
+	Uint64 elapsedTime;     ///< Timestamp_get32() units covered by the completed cycles
+	Uint16 utilization;     ///< busyTime / elapsedTime in 1/1000ths
+} BME280_Acq_BusStats;
+
+/// @brief Attach an opened sensor to <bus>
+/// @details All sensors given the same bus index must share one I2C_Handle, and sensors on different bus
+///          indices must not.  Only valid before BME280_Acq_start().
+/// @returns false if the engine is running, <bus> is out of range or the bus is full.
+Bool BME280_Acq_addSensor(Uint8 bus, BME280_Handle sensor, Uint8 sensorId);
+
+/// @brief Create the merged stream and one worker Task per bus that has sensors
+/// @details Every <period> ticks each worker triggers a Forced measurement on all of its sensors, so their
+///          conversions run concurrently, then reads each one out before the end of the period.  Workers on
+///          different buses run independently, so the sample rate scales with the number of buses.
+/// @returns false if already started, <period> is 0 or a kernel object could not be created.
+Bool BME280_Acq_start(Uint32 period);
+
+/// @brief Receive the next sample of the merged stream, waiting up to <timeout> ticks (or BIOS_WAIT_FOREVER)
+Bool BME280_Acq_pend(BME280_Acq_Sample *sample, UInt timeout);
+
+/// @brief Snapshot the counters for <bus>
+/// @returns false if <bus> is out of range.
+Bool BME280_Acq_getBusStats(Uint8 bus, BME280_Acq_BusStats *stats);
+
+#endif /* BME280_ACQ_H_ */
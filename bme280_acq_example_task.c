@@ -0,0 +1,114 @@
+/*
+ * @file bme280_acq_example_task.c
+ * @brief BME280 Acquisition Engine RTOS example
+ * @headerfile <bme280_acq.h>
+ * @details Example TI-RTOS task code acquiring two BME280s on each of two I2C buses
+ *
+ * @author bme280_tirtos contributors
+ * @date 2026
+ * @copyright (C) 2026 bme280_tirtos contributors
+ *  @n Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+ *  @n (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge,
+ *  @n publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to
+ *  @n do so, subject to the following conditions:
+ *  @n
+ *  @n The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *  @n
+ *  @n THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  @n OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ *  @n BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ *  @n OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *  @n
+ *  @n A copy of the BME280 product datasheet may be found on BOSCH SENSORTEC's product page:
+ *  @n https://www.bosch-sensortec.com/bst/products/all_products/bme280
+ */
+
+#include <string.h>
+#include <stdio.h>
+
+/* XDCtools Header files */
+#include <xdc/std.h>
+#include <xdc/runtime/System.h>
+
+/* BIOS Header files */
+#include <ti/sysbios/BIOS.h>
+#include <ti/sysbios/knl/Task.h>
+
+/* TI-RTOS Header files */
+#include <ti/drivers/I2C.h>
+
+/* Board Header files */
+#include "Board.h"
+
+#include "bme280.h"
+#include "bme280_acq.h"
+
+#define NUM_BUSES 2
+
+static char ubuf[256];
+static BME280_Object sensors[NUM_BUSES][2];
+
+void bme280_Acq_Example_Task(UArg arg0, UArg arg1)
+{
+    I2C_Params i2cParam;
+    I2C_Handle i2c;
+    BME280_Acq_Sample sample;
+    BME280_Acq_BusStats stats;
+    Uint8 bus, s;
+    Uint32 count = 0;
+
+    for (bus = 0; bus < NUM_BUSES; bus++) {
+        /* Open I2C bus driver */
+        I2C_Params_init(&i2cParam);
+        i2cParam.transferMode = I2C_MODE_BLOCKING;
+        i2cParam.transferCallbackFxn = NULL;
+        i2cParam.bitRate = I2C_400kHz;
+        i2c = I2C_open(bus, &i2cParam);  // Open I2C instance #bus with 400KHz bus speed
+        if (i2c == NULL) {
+        	System_abort("I2C: Failure opening port\r\n");
+        }
+
+        // One sensor at each of the two BME280 slave addresses; sensor ID = bus * 2 + index
+        for (s = 0; s < 2; s++) {
+        	BME280_Handle h = BME280_construct(&sensors[bus][s], i2c, BOSCH_SENSORTEC_BME280_I2CSLAVE_DEFAULT - s);
+        	if (!BME280_Handle_open(h)) {
+        		System_printf("ERROR opening BME280 %u on I2C%u\r\n", s, bus);
+        		System_flush();
+        	}
+        	BME280_Acq_addSensor(bus, h, bus * 2 + s);
+        }
+    }
+
+    // Acquire every sensor every 100ms
+    if (!BME280_Acq_start(100)) {
+    	System_abort("BME280_Acq_start() failed\r\n");
+    }
+
+    while(1) {
+
+		// Drain the merged stream, spitting to CIO console
+		BME280_Acq_pend(&sample, BIOS_WAIT_FOREVER);
+		if (sample.result != BME280_RESULT_OK) {
+			sprintf(ubuf, "%u: sensor %u failed: %d\r\n", sample.timestamp, sample.sensorId, sample.result);
+		} else {
+			sprintf(ubuf, "%u: sensor %u Temp: %d C, humidity: %d%%%%, Pressure: %u Pa\r\n", \
+							sample.timestamp,
+							sample.sensorId,
+							sample.temperature / 100,
+							sample.humidity / 1024,
+							sample.pressure / 256);
+		}
+		System_printf(ubuf);
+
+		// Report bus utilization every 100 samples
+		if (++count % 100 == 0) {
+			for (bus = 0; bus < NUM_BUSES; bus++) {
+				BME280_Acq_getBusStats(bus, &stats);
+				System_printf("I2C%u: %u samples, %u errors, %u dropped, utilization %u/1000\r\n", \
+							bus, stats.samples, stats.errors, stats.dropped, stats.utilization);
+			}
+		}
+		System_flush();
+
+    }
+}
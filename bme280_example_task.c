@@ -39,6 +39,7 @@
 /* BIOS Header files */
 #include <ti/sysbios/BIOS.h>
 #include <ti/sysbios/knl/Task.h>
+#include <ti/sysbios/knl/Clock.h>
 
 /* TI-RTOS Header files */
 #include <ti/drivers/I2C.h>
@@ -78,21 +79,33 @@ void bme280_Example_Task(UArg arg0, UArg arg1)
     	System_flush();
     }
 
+    Uint32 cycleStart = Clock_getTicks();
     while(1) {
 
-		// Read & interpret results, spitting to CIO console
-		BME280_RawData *rd = BME280_read();
-		Int32 tempC = BME280_compensated_Temperature(rd);
-		sprintf(ubuf, "Temp: %d C (%d F), humidity: %d%%%%, Pressure: %u hPa\r\n", \
-						tempC / 100,
-						((tempC * 9) / 5) / 100 + 32,
-						BME280_compensated_Humidity(rd) / 1024,
-						(BME280_compensated_Pressure(rd) / 256) / 1000);
-		System_printf(ubuf);
+		// Read & interpret results, spitting to CIO console; the read must finish within 100ms of the cycle start
+		BME280_RawData rd;
+		BME280_Result res = BME280_readUntil(cycleStart + 100, &rd);
+		if (res != BME280_RESULT_OK) {
+			System_printf("BME280 read failed: %d\r\n", res);
+		} else {
+			Int32 tempC = BME280_compensated_Temperature(&rd);
+			sprintf(ubuf, "Temp: %d C (%d F), humidity: %d%%%%, Pressure: %u hPa\r\n", \
+							tempC / 100,
+							((tempC * 9) / 5) / 100 + 32,
+							BME280_compensated_Humidity(&rd) / 1024,
+							(BME280_compensated_Pressure(&rd) / 256) / 1000);
+			System_printf(ubuf);
+		}
 		System_flush();
 
-		// Wait 500ms and poll again
-		Task_sleep(500);
+		// Wait until 500ms after the previous cycle and poll again; after an overrun restart the schedule instead of bursting
+		cycleStart += 500;
+		Int32 idle = (Int32)(cycleStart - Clock_getTicks());
+		if (idle > 0) {
+			Task_sleep(idle);
+		} else {
+			cycleStart = Clock_getTicks();
+		}
 
     }
 }
@@ -0,0 +1,217 @@
+/*
+ * @file bench_acq.c
+ * @brief Scaling benchmark for the multi-bus acquisition engine
+ * @details Runs bme280_acq.c on POSIX threads (tirtos_threads.c) against 1..BME280_ACQ_MAX_BUSES simulated buses
+ *          with two sensors each, in two configurations:
+ *           - relaxed: each bus needs far less transfer time per cycle than the period, so throughput simply
+ *             follows the sleep schedule;
+ *           - saturating: each bus needs more transfer time per cycle than the period, so every bus is busy
+ *             nearly all the time and aggregate bus throughput only grows with the number of buses if the workers
+ *             really drive them concurrently.
+ *          Every run also checks that the merged stream is in timestamp order, that no sensor ever repeats a
+ *          measurement and that no sensor is starved of samples; any violation makes the program exit nonzero.
+ *
+ *          Usage: bench_acq [milliseconds per run, default 2000]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include <xdc/std.h>
+#include <ti/sysbios/knl/Clock.h>
+
+#include "bme280.h"
+#include "bme280_acq.h"
+#include "sim_bus.h"
+
+#define SENSORS_PER_BUS 2
+
+typedef struct {
+	const char *name;
+	Uint32 transferUs;      ///< Bus time of every I2C transfer
+	Uint32 conversionUs;    ///< Sensor conversion time
+	Uint32 period;          ///< BME280_Acq_start() period, in ticks
+} BenchConfig;
+
+/* Per cycle each sensor needs at least three transfers (trigger, STATUS poll, data read).  In the saturating
+ * configuration the deadline cuts every cycle short, so about half the samples are BME280_RESULT_TIMEOUT; the
+ * worker rotates its readout order, so those timeouts must be spread over all sensors. */
+static const BenchConfig _configs[] = {
+	{ "relaxed", 100, 10000, 20 },      // Nominally 0.6ms of transfers against a 20ms period
+	{ "saturating", 5000, 1000, 25 },   // Nominally 30ms of transfers against a 25ms period
+};
+
+/// @brief What one run reports back to the parent
+typedef struct {
+	Uint32 ok;
+	Uint32 errors;
+	Uint32 dropped;
+	Uint32 transfers;       ///< Transfers seen by the simulated buses
+	Uint32 cycles;
+	Uint64 busyUs;
+	Uint32 utilization;     ///< Mean of the per-bus utilization, in 1/1000ths
+	Uint32 orderViolations; ///< Samples with a timestamp older than their predecessor
+	Uint32 staleSamples;    ///< Samples repeating or going back on a sensor's conversion sequence
+	Uint32 starved;         ///< Sensors that never delivered a BME280_RESULT_OK sample
+	Uint32 minOk;           ///< Fewest BME280_RESULT_OK samples delivered by any one sensor
+} BenchResult;
+
+static SimBus _buses[BME280_ACQ_MAX_BUSES];
+static struct I2C_Config _i2c[BME280_ACQ_MAX_BUSES];
+static BME280_Object _sensors[BME280_ACQ_MAX_BUSES][SENSORS_PER_BUS];
+
+/// @brief Set up <numBuses> buses, run the engine for <ms> milliseconds and consume its stream
+static Bool _run(const BenchConfig *cfg, Uint8 numBuses, Uint32 ms, BenchResult *r)
+{
+	Uint32 lastSeq[BME280_ACQ_MAX_BUSES * SENSORS_PER_BUS] = { 0 };
+	Uint32 okCount[BME280_ACQ_MAX_BUSES * SENSORS_PER_BUS] = { 0 };
+	Uint32 lastTimestamp = 0, end;
+	BME280_Acq_Sample sample;
+	BME280_Acq_BusStats stats;
+	BME280_Handle h;
+	Int quiet, console;
+	Uint8 b, s;
+
+	memset(r, 0, sizeof(BenchResult));
+
+	// BME280_Handle_open() is chatty; keep its console output out of the results table
+	fflush(stdout);
+	console = dup(STDOUT_FILENO);
+	quiet = open("/dev/null", O_WRONLY);
+	dup2(quiet, STDOUT_FILENO);
+	for (b = 0; b < numBuses; b++) {
+		SimBus_init(&_buses[b]);
+		SimBus_open(&_i2c[b], &_buses[b], I2C_MODE_BLOCKING, NULL);
+		for (s = 0; s < SENSORS_PER_BUS; s++) {
+			SimBus_addSlave(&_buses[b], BOSCH_SENSORTEC_BME280_I2CSLAVE_DEFAULT - s);
+			h = BME280_construct(&_sensors[b][s], &_i2c[b], BOSCH_SENSORTEC_BME280_I2CSLAVE_DEFAULT - s);
+			if (!BME280_Handle_open(h) || !BME280_Acq_addSensor(b, h, b * SENSORS_PER_BUS + s)) {
+				return false;
+			}
+		}
+		// Only now slow the bus down, so the opens above don't eat into the run
+		_buses[b].transferUs = cfg->transferUs;
+		_buses[b].conversionUs = cfg->conversionUs;
+		_buses[b].transfers = 0;
+	}
+	fflush(stdout);
+	dup2(console, STDOUT_FILENO);
+	close(console);
+	close(quiet);
+
+	if (!BME280_Acq_start(cfg->period)) {
+		return false;
+	}
+	end = Clock_getTicks() + ms;
+	while ((Int32)(end - Clock_getTicks()) > 0) {
+		if (!BME280_Acq_pend(&sample, 10)) {
+			continue;
+		}
+		if ((Int32)(sample.timestamp - lastTimestamp) < 0) {
+			r->orderViolations++;
+		}
+		lastTimestamp = sample.timestamp;
+		if (sample.result != BME280_RESULT_OK) {
+			r->errors++;
+			continue;
+		}
+		r->ok++;
+		okCount[sample.sensorId]++;
+		if (sample.raw.temperature_raw <= lastSeq[sample.sensorId]) {
+			r->staleSamples++;
+		}
+		lastSeq[sample.sensorId] = sample.raw.temperature_raw;
+	}
+
+	for (b = 0; b < numBuses; b++) {
+		BME280_Acq_getBusStats(b, &stats);
+		r->dropped += stats.dropped;
+		r->cycles += stats.cycles;
+		r->busyUs += stats.busyTime;
+		r->utilization += stats.utilization;
+		r->transfers += _buses[b].transfers;  // Read racily; close enough for a rate
+	}
+	r->utilization /= numBuses;
+
+	r->minOk = okCount[0];
+	for (s = 0; s < numBuses * SENSORS_PER_BUS; s++) {
+		if (okCount[s] == 0) {
+			r->starved++;
+		}
+		if (okCount[s] < r->minOk) {
+			r->minOk = okCount[s];
+		}
+	}
+	return true;
+}
+
+/// @brief Do one run in a child process, since the engine cannot be stopped once started
+static Bool _runIsolated(const BenchConfig *cfg, Uint8 numBuses, Uint32 ms, BenchResult *r)
+{
+	Int fds[2], status;
+	pid_t pid;
+	ssize_t n;
+
+	if (pipe(fds) != 0) {
+		return false;
+	}
+	fflush(stdout);
+	pid = fork();
+	if (pid < 0) {
+		return false;
+	}
+	if (pid == 0) {
+		close(fds[0]);
+		if (!_run(cfg, numBuses, ms, r) || write(fds[1], r, sizeof(BenchResult)) != sizeof(BenchResult)) {
+			_exit(1);
+		}
+		_exit(0);  // Skip atexit handlers; the worker threads are still running
+	}
+	close(fds[1]);
+	n = read(fds[0], r, sizeof(BenchResult));
+	close(fds[0]);
+	waitpid(pid, &status, 0);
+	return n == sizeof(BenchResult) && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+int main(int argc, char **argv)
+{
+	const BenchConfig *cfg;
+	BenchResult r;
+	Uint32 ms = argc > 1 ? (Uint32)atoi(argv[1]) : 2000;
+	double secs = ms / 1000.0, base;
+	Int failures = 0;
+	UInt c;
+	Uint8 n;
+
+	for (c = 0; c < sizeof(_configs) / sizeof(_configs[0]); c++) {
+		cfg = &_configs[c];
+		printf("\n%s: %u us/transfer, %u us/conversion, period %u ms, %u sensors/bus, %u ms/run\n",
+				cfg->name, cfg->transferUs, cfg->conversionUs, cfg->period, SENSORS_PER_BUS, ms);
+		printf("buses   ok/s  err/s  xfer/s  speedup  util%%  bus ms/cycle  dropped  order  stale  min ok/sensor\n");
+		base = 0;
+		for (n = 1; n <= BME280_ACQ_MAX_BUSES; n++) {
+			if (!_runIsolated(cfg, n, ms, &r)) {
+				printf("%5u   run failed\n", n);
+				failures++;
+				continue;
+			}
+			if (base == 0) {
+				base = r.transfers / secs;
+			}
+			printf("%5u %6.0f %6.0f %7.0f %7.2fx %5.1f %13.2f %8u %6u %6u %14u\n", n,
+					r.ok / secs, r.errors / secs, r.transfers / secs, base > 0 ? r.transfers / secs / base : 0,
+					r.utilization / 10.0, r.cycles ? r.busyUs / 1000.0 / r.cycles : 0,
+					r.dropped, r.orderViolations, r.staleSamples, r.minOk);
+			if (r.orderViolations != 0 || r.staleSamples != 0 || r.starved != 0) {
+				failures++;
+			}
+		}
+	}
+	printf("\n%s\n", failures ? "FAILED" : "PASSED");
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,28 @@
+/* Host stand-in for ti.drivers.I2C; transfers are served by the simulated bus in sim_bus.c */
+#ifndef HOST_TI_DRIVERS_I2C_H_
+#define HOST_TI_DRIVERS_I2C_H_
+
+#include <xdc/std.h>
+
+typedef enum {
+	I2C_MODE_BLOCKING,
+	I2C_MODE_CALLBACK
+} I2C_TransferMode;
+
+typedef struct I2C_Transaction {
+	Void *writeBuf;
+	size_t writeCount;
+	Void *readBuf;
+	size_t readCount;
+	Uint8 slaveAddress;
+	Void *arg;
+} I2C_Transaction;
+
+typedef struct I2C_Config *I2C_Handle;
+
+typedef Void (*I2C_CallbackFxn)(I2C_Handle handle, I2C_Transaction *txn, bool status);
+
+bool I2C_transfer(I2C_Handle handle, I2C_Transaction *txn);
+Void I2C_cancel(I2C_Handle handle);
+
+#endif /* HOST_TI_DRIVERS_I2C_H_ */
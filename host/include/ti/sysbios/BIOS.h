@@ -0,0 +1,10 @@
+/* Host stand-in for ti.sysbios.BIOS */
+#ifndef HOST_TI_SYSBIOS_BIOS_H_
+#define HOST_TI_SYSBIOS_BIOS_H_
+
+#include <xdc/std.h>
+
+#define BIOS_NO_WAIT 0
+#define BIOS_WAIT_FOREVER (~(UInt)0)
+
+#endif /* HOST_TI_SYSBIOS_BIOS_H_ */
@@ -0,0 +1,18 @@
+/* Host stand-in for ti.sysbios.gates.GateMutex */
+#ifndef HOST_TI_SYSBIOS_GATES_GATEMUTEX_H_
+#define HOST_TI_SYSBIOS_GATES_GATEMUTEX_H_
+
+#include <xdc/std.h>
+#include <xdc/runtime/Error.h>
+
+typedef struct GateMutex_Object *GateMutex_Handle;
+typedef struct {
+	Int unused;
+} GateMutex_Params;
+
+GateMutex_Handle GateMutex_create(const GateMutex_Params *params, Error_Block *eb);
+Void GateMutex_delete(GateMutex_Handle *handle);
+IArg GateMutex_enter(GateMutex_Handle handle);
+Void GateMutex_leave(GateMutex_Handle handle, IArg key);
+
+#endif /* HOST_TI_SYSBIOS_GATES_GATEMUTEX_H_ */
@@ -0,0 +1,9 @@
+/* Host stand-in for ti.sysbios.knl.Clock; one tick is one millisecond */
+#ifndef HOST_TI_SYSBIOS_KNL_CLOCK_H_
+#define HOST_TI_SYSBIOS_KNL_CLOCK_H_
+
+#include <xdc/std.h>
+
+UInt32 Clock_getTicks(Void);
+
+#endif /* HOST_TI_SYSBIOS_KNL_CLOCK_H_ */
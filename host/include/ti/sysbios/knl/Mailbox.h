@@ -0,0 +1,18 @@
+/* Host stand-in for ti.sysbios.knl.Mailbox */
+#ifndef HOST_TI_SYSBIOS_KNL_MAILBOX_H_
+#define HOST_TI_SYSBIOS_KNL_MAILBOX_H_
+
+#include <xdc/std.h>
+#include <xdc/runtime/Error.h>
+
+typedef struct Mailbox_Object *Mailbox_Handle;
+typedef struct {
+	Int unused;
+} Mailbox_Params;
+
+Mailbox_Handle Mailbox_create(SizeT msgSize, UInt numMsgs, const Mailbox_Params *params, Error_Block *eb);
+Void Mailbox_delete(Mailbox_Handle *handle);
+Bool Mailbox_post(Mailbox_Handle handle, Ptr msg, UInt timeout);
+Bool Mailbox_pend(Mailbox_Handle handle, Ptr msg, UInt timeout);
+
+#endif /* HOST_TI_SYSBIOS_KNL_MAILBOX_H_ */
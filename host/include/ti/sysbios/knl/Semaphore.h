@@ -0,0 +1,31 @@
+/* Host stand-in for ti.sysbios.knl.Semaphore; the runtime (tirtos_*.c) supplies the implementation */
+#ifndef HOST_TI_SYSBIOS_KNL_SEMAPHORE_H_
+#define HOST_TI_SYSBIOS_KNL_SEMAPHORE_H_
+
+#include <xdc/std.h>
+
+typedef enum {
+	Semaphore_Mode_COUNTING,
+	Semaphore_Mode_BINARY
+} Semaphore_Mode;
+
+typedef struct {
+	Semaphore_Mode mode;
+} Semaphore_Params;
+
+typedef struct {
+	Semaphore_Mode mode;
+	Int count;
+	Ptr os;  ///< Runtime-specific synchronization object
+} Semaphore_Struct;
+
+typedef Semaphore_Struct *Semaphore_Handle;
+
+#define Semaphore_handle(s) (s)
+
+Void Semaphore_Params_init(Semaphore_Params *params);
+Void Semaphore_construct(Semaphore_Struct *sem, Int count, const Semaphore_Params *params);
+Bool Semaphore_pend(Semaphore_Handle sem, UInt timeout);
+Void Semaphore_post(Semaphore_Handle sem);
+
+#endif /* HOST_TI_SYSBIOS_KNL_SEMAPHORE_H_ */
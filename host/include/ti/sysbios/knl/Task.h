@@ -0,0 +1,25 @@
+/* Host stand-in for ti.sysbios.knl.Task */
+#ifndef HOST_TI_SYSBIOS_KNL_TASK_H_
+#define HOST_TI_SYSBIOS_KNL_TASK_H_
+
+#include <xdc/std.h>
+#include <xdc/runtime/Error.h>
+
+typedef Void (*Task_FuncPtr)(UArg arg0, UArg arg1);
+typedef struct Task_Object *Task_Handle;
+
+typedef struct {
+	UArg arg0;
+	UArg arg1;
+	Int priority;
+	SizeT stackSize;
+} Task_Params;
+
+Void Task_sleep(UInt32 ticks);
+Void Task_Params_init(Task_Params *params);
+Task_Handle Task_create(Task_FuncPtr fxn, const Task_Params *params, Error_Block *eb);
+Void Task_delete(Task_Handle *handle);
+UInt Task_disable(Void);
+Void Task_restore(UInt key);
+
+#endif /* HOST_TI_SYSBIOS_KNL_TASK_H_ */
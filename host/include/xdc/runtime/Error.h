@@ -0,0 +1,13 @@
+/* Host stand-in for xdc.runtime.Error */
+#ifndef HOST_XDC_RUNTIME_ERROR_H_
+#define HOST_XDC_RUNTIME_ERROR_H_
+
+#include <xdc/std.h>
+
+typedef struct {
+	Int code;
+} Error_Block;
+
+#define Error_init(eb) ((eb)->code = 0)
+
+#endif /* HOST_XDC_RUNTIME_ERROR_H_ */
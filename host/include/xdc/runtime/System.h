@@ -0,0 +1,12 @@
+/* Host stand-in for xdc.runtime.System */
+#ifndef HOST_XDC_RUNTIME_SYSTEM_H_
+#define HOST_XDC_RUNTIME_SYSTEM_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define System_printf printf
+#define System_flush() fflush(stdout)
+#define System_abort(msg) do { fputs(msg, stderr); abort(); } while (0)
+
+#endif /* HOST_XDC_RUNTIME_SYSTEM_H_ */
@@ -0,0 +1,9 @@
+/* Host stand-in for xdc.runtime.Timestamp; one unit is one microsecond */
+#ifndef HOST_XDC_RUNTIME_TIMESTAMP_H_
+#define HOST_XDC_RUNTIME_TIMESTAMP_H_
+
+#include <xdc/std.h>
+
+UInt32 Timestamp_get32(Void);
+
+#endif /* HOST_XDC_RUNTIME_TIMESTAMP_H_ */
@@ -0,0 +1,31 @@
+/*
+ * Host stand-in for the XDCtools standard types, just enough to build the driver with a native compiler.
+ */
+#ifndef HOST_XDC_STD_H_
+#define HOST_XDC_STD_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+typedef void Void;
+typedef void *Ptr;
+typedef char Char;
+typedef int Int;
+typedef unsigned int UInt;
+typedef unsigned short Bool;
+typedef size_t SizeT;
+typedef uintptr_t UArg;
+typedef intptr_t IArg;
+
+typedef int8_t Int8;
+typedef int16_t Int16;
+typedef int32_t Int32;
+typedef int64_t Int64;
+typedef uint8_t Uint8;
+typedef uint16_t Uint16;
+typedef uint32_t Uint32;
+typedef uint64_t Uint64;
+typedef uint32_t UInt32;
+
+#endif /* HOST_XDC_STD_H_ */
@@ -0,0 +1,184 @@
+/*
+ * @file sim_bus.c
+ * @brief Simulated I2C bus with BME280 slaves and fault injection, for host builds
+ */
+
+#include <string.h>
+
+#include "sim_bus.h"
+#include "bme280.h"
+
+/* Calibration constants from the example in the BME280 datasheet */
+static const Uint8 _simCalib00[26] = {
+	0x70, 0x6B, 0x43, 0x67, 0x18, 0xFC,                 // dig_T1..T3
+	0x7D, 0x8E, 0x43, 0xD6, 0xD0, 0x0B, 0x27, 0x0B,     // dig_P1..P4
+	0x8C, 0x00, 0xF9, 0xFF, 0x8C, 0x3C, 0xF8, 0xC6,     // dig_P5..P8
+	0x70, 0x17, 0x00, 0x4B                              // dig_P9, reserved, dig_H1
+};
+static const Uint8 _simCalib26[7] = { 0x6A, 0x01, 0x00, 0x13, 0x2C, 0x03, 0x1E };  // dig_H2..H6
+
+/// @brief Put the data registers back to their reset value (0x80000 in PRESS/TEMP, 0x8000 in HUM)
+static Void _simResetData(SimBme280 *s)
+{
+	memset(&s->regs[BME280_REG_PRESSURE], 0, 8);
+	s->regs[BME280_REG_PRES_MSB] = 0x80;
+	s->regs[BME280_REG_TEMP_MSB] = 0x80;
+	s->regs[BME280_REG_HUM_MSB] = 0x80;
+	s->converting = false;
+}
+
+/// @brief Latch the result of a finished conversion; every conversion yields distinct values
+static Void _simUpdate(SimBme280 *s)
+{
+	Uint32 press, temp;
+
+	if (!s->converting || Host_nowUs() < s->convEndUs) {
+		return;
+	}
+	s->converting = false;
+	s->seq++;
+	press = 415148 + (s->seq & 0xFFF);
+	temp = 519888 + (s->seq & 0xFFF);
+	s->regs[BME280_REG_PRES_MSB] = press >> 12;
+	s->regs[BME280_REG_PRES_LSB] = press >> 4;
+	s->regs[BME280_REG_PRES_XLSB] = press << 4;
+	s->regs[BME280_REG_TEMP_MSB] = temp >> 12;
+	s->regs[BME280_REG_TEMP_LSB] = temp >> 4;
+	s->regs[BME280_REG_TEMP_XLSB] = temp << 4;
+	s->regs[BME280_REG_HUM_MSB] = 0x66;
+	s->regs[BME280_REG_HUM_LSB] = s->seq;
+}
+
+static Void _simWrite(SimBus *bus, SimBme280 *s, Uint8 reg, Uint8 value)
+{
+	s->regs[reg] = value;
+	if (reg == BME280_REG_RESET && value == BME280_RESET_ASSERT) {
+		s->regs[BME280_REG_CTRL_MEAS] = 0;
+		_simResetData(s);
+	} else if (reg == BME280_REG_CTRL_MEAS && (value & 0x03) == BME280_CTRL_MEAS_MODE_FORCED) {
+		s->converting = true;
+		s->convEndUs = Host_nowUs() + bus->conversionUs;
+	}
+}
+
+static Uint8 _simRead(SimBme280 *s, Uint8 reg)
+{
+	if (reg == BME280_REG_STATUS) {
+		return (s->converting || s->stuckMeasuring) ? BME280_STATUS_MEASURING : 0;
+	}
+	return s->regs[reg];
+}
+
+Void SimBus_init(SimBus *bus)
+{
+	memset(bus, 0, sizeof(SimBus));
+	pthread_mutex_init(&bus->lock, NULL);
+	bus->transferUs = 100;
+	bus->conversionUs = 10000;
+}
+
+SimBme280 *SimBus_addSlave(SimBus *bus, Uint8 addr)
+{
+	SimBme280 *s = &bus->slaves[bus->numSlaves++];
+
+	memset(s, 0, sizeof(SimBme280));
+	s->addr = addr;
+	s->regs[BME280_REG_ID] = BME280_CHIPID;
+	memcpy(&s->regs[BME280_REG_CALIB00], _simCalib00, sizeof(_simCalib00));
+	memcpy(&s->regs[BME280_REG_CALIB26], _simCalib26, sizeof(_simCalib26));
+	_simResetData(s);
+	return s;
+}
+
+I2C_Handle SimBus_open(struct I2C_Config *config, SimBus *bus, I2C_TransferMode mode, I2C_CallbackFxn callback)
+{
+	config->bus = bus;
+	config->mode = mode;
+	config->callback = callback;
+	config->hung = NULL;
+	return config;
+}
+
+Void SimBus_completeHung(I2C_Handle handle, bool status)
+{
+	I2C_Transaction *txn = handle->hung;
+
+	if (txn != NULL) {
+		handle->hung = NULL;
+		handle->callback(handle, txn, status);
+	}
+}
+
+/// @brief Run one transaction against the slaves; false if nobody ACKs or a NACK is injected
+static bool _simExecute(SimBus *bus, I2C_Transaction *txn)
+{
+	const Uint8 *wr = txn->writeBuf;
+	Uint8 *rd = txn->readBuf;
+	SimBme280 *s = NULL;
+	size_t i;
+
+	for (i = 0; i < bus->numSlaves; i++) {
+		if (bus->slaves[i].addr == txn->slaveAddress) {
+			s = &bus->slaves[i];
+		}
+	}
+	if (s == NULL || bus->nackNext > 0 || (bus->nackEvery != 0 && bus->transfers % bus->nackEvery == 0)) {
+		if (bus->nackNext > 0) {
+			bus->nackNext--;
+		}
+		bus->nacks++;
+		return false;
+	}
+
+	_simUpdate(s);
+	if (txn->writeCount > 0) {
+		s->pointer = wr[0];
+	}
+	for (i = 0; i + 1 < txn->writeCount; i += 2) {
+		_simWrite(bus, s, wr[i], wr[i + 1]);  // Writes are (register, value) pairs
+	}
+	for (i = 0; i < txn->readCount; i++) {
+		rd[i] = _simRead(s, (Uint8)(s->pointer + i));
+	}
+	return true;
+}
+
+bool I2C_transfer(I2C_Handle handle, I2C_Transaction *txn)
+{
+	SimBus *bus = handle->bus;
+	bool ok;
+
+	pthread_mutex_lock(&bus->lock);
+	bus->transfers++;
+	bus->lastStartUs = Host_nowUs();
+	if (bus->hangNext > 0 && bus->hangSkip > 0) {
+		bus->hangSkip--;
+	} else if (bus->hangNext > 0) {
+		bus->hangNext--;
+		bus->hangs++;
+		if (handle->mode == I2C_MODE_CALLBACK) {
+			handle->hung = txn;  // Queued, but never completes on its own
+			pthread_mutex_unlock(&bus->lock);
+			return true;
+		}
+		Host_busDelayUs(bus->hangUs);  // A blocking transfer holds the caller for as long as the slave does
+		pthread_mutex_unlock(&bus->lock);
+		return false;
+	}
+	Host_busDelayUs(bus->transferUs);
+	ok = _simExecute(bus, txn);
+	pthread_mutex_unlock(&bus->lock);
+
+	if (handle->mode == I2C_MODE_CALLBACK) {
+		handle->callback(handle, txn, ok);
+		return true;
+	}
+	return ok;
+}
+
+Void I2C_cancel(I2C_Handle handle)
+{
+	if (handle->hung != NULL && !handle->bus->ignoreCancel) {
+		SimBus_completeHung(handle, false);
+	}
+}
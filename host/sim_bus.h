@@ -0,0 +1,76 @@
+/*
+ * @file sim_bus.h
+ * @brief Simulated I2C bus with BME280 slaves and fault injection, for host builds
+ * @details Serves I2C_transfer()/I2C_cancel() for the driver.  Time passing on the bus is delegated to the
+ *          runtime (tirtos_virtual.c advances a virtual clock, tirtos_threads.c really sleeps), so the same bus
+ *          model backs both the deadline tests and the acquisition benchmark.
+ */
+
+#ifndef SIM_BUS_H_
+#define SIM_BUS_H_
+
+#include <pthread.h>
+
+#include <xdc/std.h>
+#include <ti/drivers/I2C.h>
+
+#define SIM_BUS_MAX_SLAVES 4
+
+/// @brief One simulated BME280
+typedef struct {
+	Uint8 addr;
+	Uint8 regs[256];
+	Uint8 pointer;          ///< Register pointer set by the last write
+	Bool converting;        ///< Forced conversion in progress
+	Uint64 convEndUs;       ///< Runtime time at which the conversion completes
+	Uint32 seq;             ///< Number of conversions completed; encoded into the data registers
+	Bool stuckMeasuring;    ///< Fault: STATUS reports MEASURING forever
+} SimBme280;
+
+/// @brief A bus and its slaves
+typedef struct {
+	pthread_mutex_t lock;   ///< Held for the duration of each transfer; the bus is a shared resource
+	SimBme280 slaves[SIM_BUS_MAX_SLAVES];
+	Uint8 numSlaves;
+	Uint32 transferUs;      ///< Bus time taken by every transfer
+	Uint32 conversionUs;    ///< Time from a Forced CTRL_MEAS write until the data is ready
+
+	/* Fault injection; all counters are consumed one per transfer */
+	Uint32 nackNext;        ///< Fail this many upcoming transfers with a NACK
+	Uint32 nackEvery;       ///< If nonzero, additionally NACK every n-th transfer
+	Uint32 hangNext;        ///< This many upcoming transfers hang...
+	Uint32 hangSkip;        ///< ...after letting this many through first
+	Uint32 hangUs;          ///< Blocking mode: how long a hung transfer holds the caller before failing
+	Bool ignoreCancel;      ///< Callback mode: a hung transfer does not call back on I2C_cancel()
+
+	/* Statistics */
+	Uint32 transfers;
+	Uint32 nacks;
+	Uint32 hangs;
+	Uint64 lastStartUs;     ///< Time the most recent transfer was started
+} SimBus;
+
+/// @brief What the driver sees as an I2C_Handle
+struct I2C_Config {
+	SimBus *bus;
+	I2C_TransferMode mode;
+	I2C_CallbackFxn callback;
+	I2C_Transaction *hung;  ///< Callback mode: transaction that will not complete until cancelled
+};
+
+/// @brief Initialize <bus> with no slaves, 100us transfers and 10ms conversions
+Void SimBus_init(SimBus *bus);
+/// @brief Attach a BME280 at <addr>, with the datasheet's example calibration constants
+SimBme280 *SimBus_addSlave(SimBus *bus, Uint8 addr);
+/// @brief Fill in <config> so it can be used as an I2C_Handle on <bus>
+I2C_Handle SimBus_open(struct I2C_Config *config, SimBus *bus, I2C_TransferMode mode, I2C_CallbackFxn callback);
+/// @brief Callback mode: let a hung (possibly cancel-ignoring) transfer complete now with <status>
+Void SimBus_completeHung(I2C_Handle handle, bool status);
+
+/* Provided by the runtime (tirtos_virtual.c or tirtos_threads.c) */
+/// @brief Current time in microseconds, on the same clock as Clock_getTicks()
+Uint64 Host_nowUs(Void);
+/// @brief Let <us> microseconds of bus time pass
+Void Host_busDelayUs(Uint32 us);
+
+#endif /* SIM_BUS_H_ */
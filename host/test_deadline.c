@@ -0,0 +1,268 @@
+/*
+ * @file test_deadline.c
+ * @brief Worst-case latency and freshness tests for the deadline-bounded read API
+ * @details Runs BME280_Handle_readUntil() against a simulated bus on a virtual clock while injecting NACKs,
+ *          hung transfers and a stuck MEASURING bit, and checks that
+ *           - every call returns by its deadline plus the bound documented in bme280.h,
+ *           - no transfer is started after the deadline,
+ *           - <out> is never written unless BME280_RESULT_OK is returned,
+ *           - every BME280_RESULT_OK carries a conversion not handed out before.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <xdc/std.h>
+#include <ti/sysbios/knl/Clock.h>
+
+#include "bme280.h"
+#include "sim_bus.h"
+
+#define ADDR BOSCH_SENSORTEC_BME280_I2CSLAVE_DEFAULT
+#define DEADLINE 50  // Ticks allowed per read; a conversion takes 10
+
+static Int _failures;
+static Uint32 _recoveries;
+
+#define CHECK(cond, ...) do { \
+		if (!(cond)) { \
+			_failures++; \
+			printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+			printf(__VA_ARGS__); \
+			printf("\n"); \
+		} \
+	} while (0)
+
+/// @brief One fixture: a bus with a single sensor, driven in blocking or callback mode
+typedef struct {
+	SimBus bus;
+	SimBme280 *slave;
+	struct I2C_Config config;
+	BME280_Object obj;
+	BME280_Handle handle;
+	Bool callbackMode;
+	Uint32 lastSeq;  ///< temperature_raw of the last fresh measurement
+} Fixture;
+
+static Void _countRecovery(I2C_Handle hand)
+{
+	_recoveries++;
+}
+
+static Void _setup(Fixture *f, Bool callbackMode)
+{
+	SimBus_init(&f->bus);
+	f->slave = SimBus_addSlave(&f->bus, ADDR);
+	f->callbackMode = callbackMode;
+	SimBus_open(&f->config, &f->bus, callbackMode ? I2C_MODE_CALLBACK : I2C_MODE_BLOCKING, BME280_transferCallback);
+	f->handle = BME280_construct(&f->obj, &f->config, ADDR);
+	BME280_Handle_setCallbackMode(f->handle, callbackMode);
+	f->lastSeq = 0;
+	CHECK(BME280_Handle_open(f->handle), "open failed");
+}
+
+/// @brief Worst-case completion time, in microseconds, for a call made at <callUs> with <deadline>, per bme280.h
+static Uint64 _boundUs(Fixture *f, Uint32 deadline, Uint64 callUs)
+{
+	Uint64 bound = (Uint64)deadline * 1000;
+
+	if (bound < callUs) {
+		bound = callUs;  // Already expired on entry (ticks are truncated)
+	}
+
+	if (f->callbackMode) {
+		return bound + BME280_I2C_CANCEL_WAIT * 1000;
+	}
+	// Blocking: one transfer may already be running at the deadline
+	return bound + (f->bus.hangUs > f->bus.transferUs ? f->bus.hangUs : f->bus.transferUs);
+}
+
+/// @brief Do one read due <ticks> from now and check the invariants; returns the result
+static BME280_Result _readWithin(Fixture *f, Uint32 ticks, const char *what)
+{
+	BME280_RawData out, canary;
+	BME280_Result res;
+	Uint32 deadline = Clock_getTicks() + ticks;
+	Uint64 callUs, endUs;
+
+	memset(&canary, 0xA5, sizeof(canary));
+	out = canary;
+	f->bus.lastStartUs = 0;
+	callUs = Host_nowUs();
+	res = BME280_Handle_readUntil(f->handle, deadline, &out);
+	endUs = Host_nowUs();
+
+	CHECK(f->bus.lastStartUs < (Uint64)deadline * 1000, "%s: transfer started %lluus after the deadline",
+			what, (unsigned long long)(f->bus.lastStartUs - (Uint64)deadline * 1000));
+
+	CHECK(endUs <= _boundUs(f, deadline, callUs), "%s: returned at %lluus, bound %lluus (result %d)",
+			what, (unsigned long long)endUs, (unsigned long long)_boundUs(f, deadline, callUs), res);
+	if (res != BME280_RESULT_OK) {
+		CHECK(memcmp(&out, &canary, sizeof(out)) == 0, "%s: <out> written on result %d", what, res);
+	} else {
+		CHECK(out.temperature_raw > f->lastSeq, "%s: stale measurement returned as fresh", what);
+		f->lastSeq = out.temperature_raw;
+	}
+	return res;
+}
+
+static BME280_Result _read(Fixture *f, const char *what)
+{
+	return _readWithin(f, DEADLINE, what);
+}
+
+static Void test_healthy(Bool cb)
+{
+	Fixture f;
+
+	_setup(&f, cb);
+	CHECK(_read(&f, "healthy") == BME280_RESULT_OK, "healthy read failed");
+	CHECK(_read(&f, "healthy again") == BME280_RESULT_OK, "second healthy read failed");
+
+	// A conversion finishing shortly before the deadline must still be read out in time
+	f.bus.conversionUs = (DEADLINE - BME280_DEADLINE_RESERVE - 1) * 1000;
+	CHECK(_read(&f, "late conversion") == BME280_RESULT_OK, "conversion done before the deadline was not read");
+
+	// A deadline shorter than the head start must still leave time to poll a fast conversion
+	f.bus.conversionUs = 1000;
+	CHECK(_readWithin(&f, BME280_STATUS_MINIMUM_WAIT - 1, "short deadline") == BME280_RESULT_OK,
+			"head start slept through a short deadline");
+
+	// Nothing may touch the bus once the deadline has passed
+	f.bus.transfers = 0;
+	CHECK(_readWithin(&f, 0, "expired") == BME280_RESULT_TIMEOUT, "expired deadline not reported as timeout");
+	CHECK(f.bus.transfers == 0, "%u transfers made after the deadline", f.bus.transfers);
+}
+
+static Void test_nack(Bool cb)
+{
+	Fixture f;
+
+	_setup(&f, cb);
+	_recoveries = 0;
+	BME280_setBusRecoveryFxn(_countRecovery);
+	f.bus.nackNext = 1000;
+	CHECK(_read(&f, "nack") == BME280_RESULT_BUS_ERROR, "persistent NACK not reported");
+	CHECK(_recoveries == BME280_I2C_RETRIES, "expected %u recoveries, got %u", BME280_I2C_RETRIES, _recoveries);
+	BME280_setBusRecoveryFxn(NULL);
+
+	f.bus.nackNext = 0;
+	f.bus.nackEvery = 3;
+	CHECK(_read(&f, "flaky") == BME280_RESULT_OK, "retries did not ride out an intermittent NACK");
+}
+
+static Void test_stuck_measuring(Bool cb)
+{
+	Fixture f;
+
+	_setup(&f, cb);
+	f.slave->stuckMeasuring = true;
+	CHECK(_read(&f, "stuck") == BME280_RESULT_TIMEOUT, "stuck MEASURING not reported as timeout");
+	f.slave->stuckMeasuring = false;
+	CHECK(_read(&f, "unstuck") == BME280_RESULT_OK, "no recovery after MEASURING cleared");
+}
+
+/// @brief Contents of a transaction as the I2C driver sees them
+typedef struct {
+	I2C_Transaction txn;
+	Uint8 tx[2];
+} TxnSnapshot;
+
+static Void _snapshot(TxnSnapshot *snap, const I2C_Transaction *txn)
+{
+	memset(snap, 0, sizeof(TxnSnapshot));
+	if (txn != NULL) {
+		snap->txn = *txn;
+		memcpy(snap->tx, txn->writeBuf, txn->writeCount < sizeof(snap->tx) ? txn->writeCount : sizeof(snap->tx));
+	}
+}
+
+static Void test_hang(Bool cb)
+{
+	Fixture f;
+	TxnSnapshot hung, after;
+	Uint32 skip;
+
+	// Hang each transfer of a read in turn: CTRL_MEAS write, two STATUS polls, data read
+	for (skip = 0; skip < 4; skip++) {
+		_setup(&f, cb);
+		f.bus.hangUs = 200000;  // Blocking mode: the slave holds the caller for 200ms, well past the deadline
+		f.bus.hangSkip = skip;
+		f.bus.hangNext = 1;
+		CHECK(_read(&f, "hang") != BME280_RESULT_OK, "hung transfer #%u not reported", skip);
+		CHECK(f.bus.hangs == 1, "transfer #%u was never reached", skip);
+		CHECK(_read(&f, "after hang") == BME280_RESULT_OK, "no recovery after hung transfer #%u", skip);
+	}
+
+	if (cb) {
+		// A slave so wedged that even I2C_cancel() doesn't complete the transfer
+		_setup(&f, cb);
+		f.bus.ignoreCancel = true;
+		f.bus.hangSkip = 1;  // Hang the STATUS poll, so the next call's CTRL_MEAS write would differ from it
+		f.bus.hangNext = 1;
+		CHECK(_read(&f, "ignored cancel") == BME280_RESULT_TIMEOUT, "hung transfer not reported as timeout");
+		_snapshot(&hung, f.config.hung);
+		CHECK(_read(&f, "still in flight") == BME280_RESULT_TIMEOUT, "transaction reused while still in flight");
+		_snapshot(&after, f.config.hung);
+		CHECK(memcmp(&hung, &after, sizeof(hung)) == 0, "hung transaction modified while the I2C driver owns it");
+		SimBus_completeHung(&f.config, true);  // The driver finally gives the transaction back
+		CHECK(_read(&f, "completed late") == BME280_RESULT_OK, "no recovery after late completion");
+	}
+}
+
+static Void test_stale()
+{
+	Fixture f;
+	BME280_RawData out;
+
+	_setup(&f, false);
+	CHECK(BME280_Handle_readMeasurementsUntil(f.handle, Clock_getTicks() + DEADLINE, &out) == BME280_RESULT_NO_DATA,
+			"read without start did not report NO_DATA");
+	CHECK(BME280_Handle_start(f.handle, Clock_getTicks() + DEADLINE) == BME280_RESULT_OK, "start failed");
+	CHECK(BME280_Handle_readMeasurementsUntil(f.handle, Clock_getTicks() + DEADLINE, &out) == BME280_RESULT_OK,
+			"read after start failed");
+	CHECK(BME280_Handle_readMeasurementsUntil(f.handle, Clock_getTicks() + DEADLINE, &out) == BME280_RESULT_NO_DATA,
+			"second read after one start did not report NO_DATA");
+}
+
+/// @brief Random mix of all faults and deadlines; only the invariants in _read() are checked
+static Void test_random(Bool cb)
+{
+	Fixture f;
+	Uint32 i;
+
+	srand(cb ? 2 : 1);
+	_setup(&f, cb);
+	f.bus.hangUs = 3000;
+	for (i = 0; i < 2000; i++) {
+		f.bus.nackNext = rand() % 8 == 0 ? rand() % 4 : 0;
+		f.bus.nackEvery = rand() % 4 == 0 ? 2 + rand() % 5 : 0;
+		f.bus.hangNext = rand() % 8 == 0 ? 1 : 0;
+		f.bus.ignoreCancel = cb && rand() % 4 == 0;
+		f.slave->stuckMeasuring = rand() % 10 == 0;
+		f.bus.conversionUs = 1000 + rand() % 60000;  // Sometimes longer than DEADLINE
+		_read(&f, "random");
+		if (f.config.hung != NULL && rand() % 2) {
+			SimBus_completeHung(&f.config, rand() % 2);
+		}
+	}
+}
+
+int main(void)
+{
+	Bool cb;
+
+	for (cb = 0; cb <= 1; cb++) {
+		printf("--- %s mode\n", cb ? "callback" : "blocking");
+		test_healthy(cb);
+		test_nack(cb);
+		test_stuck_measuring(cb);
+		test_hang(cb);
+		test_random(cb);
+	}
+	test_stale();
+
+	printf("%s (%d failures)\n", _failures ? "FAILED" : "PASSED", _failures);
+	return _failures ? 1 : 0;
+}
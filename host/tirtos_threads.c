@@ -0,0 +1,383 @@
+/*
+ * @file tirtos_threads.c
+ * @brief TI-RTOS stand-in running Tasks as POSIX threads on the real clock
+ * @details Used by the acquisition benchmark: each worker Task becomes a pthread, sleeps and bus transfers take
+ *          real time, so buses driven by different workers really do run in parallel.  As on SYS/BIOS,
+ *          Task_sleep() and timed pends wake on a tick boundary (one tick = 1000us).
+ *          Task priorities and stack sizes are ignored, and Task_delete() only supports Tasks that have not
+ *          started running yet (i.e. created and deleted inside the same Task_disable() section).
+ */
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+
+#include <xdc/std.h>
+#include <xdc/runtime/Error.h>
+#include <xdc/runtime/Timestamp.h>
+#include <ti/sysbios/BIOS.h>
+#include <ti/sysbios/knl/Clock.h>
+#include <ti/sysbios/knl/Task.h>
+#include <ti/sysbios/knl/Semaphore.h>
+#include <ti/sysbios/knl/Mailbox.h>
+#include <ti/sysbios/gates/GateMutex.h>
+
+#include "sim_bus.h"
+
+/* Clock */
+
+static pthread_once_t _epochOnce = PTHREAD_ONCE_INIT;
+static struct timespec _epoch;
+
+static Void _initEpoch(Void)
+{
+	clock_gettime(CLOCK_MONOTONIC, &_epoch);
+}
+
+Uint64 Host_nowUs(Void)
+{
+	struct timespec now;
+
+	pthread_once(&_epochOnce, _initEpoch);
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (Uint64)(now.tv_sec - _epoch.tv_sec) * 1000000 + (now.tv_nsec - _epoch.tv_nsec) / 1000;
+}
+
+/// @brief Convert a Host_nowUs() time to an absolute CLOCK_MONOTONIC time
+static Void _toTimespec(Uint64 us, struct timespec *ts)
+{
+	pthread_once(&_epochOnce, _initEpoch);
+	ts->tv_sec = _epoch.tv_sec + (time_t)(us / 1000000);
+	ts->tv_nsec = _epoch.tv_nsec + (long)(us % 1000000) * 1000;
+	if (ts->tv_nsec >= 1000000000) {
+		ts->tv_sec++;
+		ts->tv_nsec -= 1000000000;
+	}
+}
+
+/// @brief Absolute time of the <ticks>-th tick boundary from now
+static Void _tickDeadline(UInt ticks, struct timespec *ts)
+{
+	_toTimespec((Host_nowUs() / 1000 + ticks) * 1000, ts);
+}
+
+/// @brief Sleep until the absolute time <ts>
+static Void _sleepUntil(const struct timespec *ts)
+{
+	while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, ts, NULL) == EINTR) {
+	}
+}
+
+Void Host_busDelayUs(Uint32 us)
+{
+	struct timespec ts;
+
+	_toTimespec(Host_nowUs() + us, &ts);
+	_sleepUntil(&ts);
+}
+
+UInt32 Clock_getTicks(Void)
+{
+	return (UInt32)(Host_nowUs() / 1000);
+}
+
+UInt32 Timestamp_get32(Void)
+{
+	return (UInt32)Host_nowUs();
+}
+
+/* Blocking primitives, all built on one mutex + condition variable pair */
+
+typedef struct {
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+} HostMonitor;
+
+static Void _monitorInit(HostMonitor *m)
+{
+	pthread_condattr_t attr;
+
+	pthread_mutex_init(&m->lock, NULL);
+	pthread_condattr_init(&attr);
+	pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+	pthread_cond_init(&m->cond, &attr);
+	pthread_condattr_destroy(&attr);
+}
+
+static Void _monitorDestroy(HostMonitor *m)
+{
+	pthread_cond_destroy(&m->cond);
+	pthread_mutex_destroy(&m->lock);
+}
+
+/// @brief With m->lock held, wait for a signal; false once <timeout> (BIOS semantics) has elapsed
+static Bool _monitorWait(HostMonitor *m, UInt timeout, const struct timespec *deadline)
+{
+	if (timeout == BIOS_WAIT_FOREVER) {
+		pthread_cond_wait(&m->cond, &m->lock);
+		return true;
+	}
+	if (timeout == BIOS_NO_WAIT) {
+		return false;
+	}
+	return pthread_cond_timedwait(&m->cond, &m->lock, deadline) != ETIMEDOUT;
+}
+
+/* Task */
+
+struct Task_Object {
+	Task_FuncPtr fxn;
+	UArg arg0;
+	UArg arg1;
+	Bool deleted;
+	pthread_t thread;
+};
+
+/// @brief Held off by Task_disable(); new Tasks wait here before running
+static HostMonitor _sched = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER };
+static UInt _schedDisabled;
+
+Void Task_sleep(UInt32 ticks)
+{
+	struct timespec ts;
+
+	if (ticks > 0) {
+		_tickDeadline(ticks, &ts);
+		_sleepUntil(&ts);
+	}
+}
+
+Void Task_Params_init(Task_Params *params)
+{
+	memset(params, 0, sizeof(Task_Params));
+	params->priority = 1;
+}
+
+static Void *_taskMain(Void *arg)
+{
+	struct Task_Object *task = arg;
+
+	pthread_mutex_lock(&_sched.lock);
+	while (_schedDisabled > 0) {
+		pthread_cond_wait(&_sched.cond, &_sched.lock);
+	}
+	pthread_mutex_unlock(&_sched.lock);
+
+	if (task->deleted) {
+		free(task);
+	} else {
+		task->fxn(task->arg0, task->arg1);
+	}
+	return NULL;
+}
+
+Task_Handle Task_create(Task_FuncPtr fxn, const Task_Params *params, Error_Block *eb)
+{
+	struct Task_Object *task = calloc(1, sizeof(struct Task_Object));
+
+	if (task == NULL) {
+		return NULL;
+	}
+	task->fxn = fxn;
+	task->arg0 = params != NULL ? params->arg0 : 0;
+	task->arg1 = params != NULL ? params->arg1 : 0;
+	if (pthread_create(&task->thread, NULL, _taskMain, task) != 0) {
+		free(task);
+		return NULL;
+	}
+	pthread_detach(task->thread);
+	return task;
+}
+
+Void Task_delete(Task_Handle *handle)
+{
+	(*handle)->deleted = true;  // Freed by the thread once the scheduler is restored
+	*handle = NULL;
+}
+
+UInt Task_disable(Void)
+{
+	UInt key;
+
+	pthread_mutex_lock(&_sched.lock);
+	key = _schedDisabled++;
+	pthread_mutex_unlock(&_sched.lock);
+	return key;
+}
+
+Void Task_restore(UInt key)
+{
+	pthread_mutex_lock(&_sched.lock);
+	_schedDisabled = key;
+	if (_schedDisabled == 0) {
+		pthread_cond_broadcast(&_sched.cond);
+	}
+	pthread_mutex_unlock(&_sched.lock);
+}
+
+/* Semaphore */
+
+Void Semaphore_Params_init(Semaphore_Params *params)
+{
+	params->mode = Semaphore_Mode_COUNTING;
+}
+
+Void Semaphore_construct(Semaphore_Struct *sem, Int count, const Semaphore_Params *params)
+{
+	HostMonitor *m = malloc(sizeof(HostMonitor));
+
+	if (m == NULL) {
+		abort();
+	}
+	_monitorInit(m);
+	sem->mode = params != NULL ? params->mode : Semaphore_Mode_COUNTING;
+	sem->count = count;
+	sem->os = m;
+}
+
+Bool Semaphore_pend(Semaphore_Handle sem, UInt timeout)
+{
+	HostMonitor *m = sem->os;
+	struct timespec deadline;
+	Bool ok = true;
+
+	_tickDeadline(timeout, &deadline);
+	pthread_mutex_lock(&m->lock);
+	while (sem->count == 0 && ok) {
+		ok = _monitorWait(m, timeout, &deadline);
+	}
+	if (sem->count > 0) {
+		sem->count--;
+		ok = true;
+	}
+	pthread_mutex_unlock(&m->lock);
+	return ok;
+}
+
+Void Semaphore_post(Semaphore_Handle sem)
+{
+	HostMonitor *m = sem->os;
+
+	pthread_mutex_lock(&m->lock);
+	if (sem->mode == Semaphore_Mode_BINARY) {
+		sem->count = 1;
+	} else {
+		sem->count++;
+	}
+	pthread_cond_broadcast(&m->cond);
+	pthread_mutex_unlock(&m->lock);
+}
+
+/* Mailbox: a fixed-size ring of fixed-size messages */
+
+struct Mailbox_Object {
+	HostMonitor m;
+	SizeT msgSize;
+	UInt numMsgs;
+	UInt head;
+	UInt count;
+	Uint8 *buf;
+};
+
+Mailbox_Handle Mailbox_create(SizeT msgSize, UInt numMsgs, const Mailbox_Params *params, Error_Block *eb)
+{
+	struct Mailbox_Object *mbx = calloc(1, sizeof(struct Mailbox_Object));
+
+	if (mbx == NULL) {
+		return NULL;
+	}
+	mbx->buf = malloc(msgSize * numMsgs);
+	if (mbx->buf == NULL) {
+		free(mbx);
+		return NULL;
+	}
+	_monitorInit(&mbx->m);
+	mbx->msgSize = msgSize;
+	mbx->numMsgs = numMsgs;
+	return mbx;
+}
+
+Void Mailbox_delete(Mailbox_Handle *handle)
+{
+	_monitorDestroy(&(*handle)->m);
+	free((*handle)->buf);
+	free(*handle);
+	*handle = NULL;
+}
+
+Bool Mailbox_post(Mailbox_Handle mbx, Ptr msg, UInt timeout)
+{
+	struct timespec deadline;
+	Bool ok = true;
+
+	_tickDeadline(timeout, &deadline);
+	pthread_mutex_lock(&mbx->m.lock);
+	while (mbx->count == mbx->numMsgs && ok) {
+		ok = _monitorWait(&mbx->m, timeout, &deadline);
+	}
+	ok = mbx->count < mbx->numMsgs;
+	if (ok) {
+		memcpy(&mbx->buf[((mbx->head + mbx->count) % mbx->numMsgs) * mbx->msgSize], msg, mbx->msgSize);
+		mbx->count++;
+		pthread_cond_broadcast(&mbx->m.cond);
+	}
+	pthread_mutex_unlock(&mbx->m.lock);
+	return ok;
+}
+
+Bool Mailbox_pend(Mailbox_Handle mbx, Ptr msg, UInt timeout)
+{
+	struct timespec deadline;
+	Bool ok = true;
+
+	_tickDeadline(timeout, &deadline);
+	pthread_mutex_lock(&mbx->m.lock);
+	while (mbx->count == 0 && ok) {
+		ok = _monitorWait(&mbx->m, timeout, &deadline);
+	}
+	ok = mbx->count > 0;
+	if (ok) {
+		memcpy(msg, &mbx->buf[mbx->head * mbx->msgSize], mbx->msgSize);
+		mbx->head = (mbx->head + 1) % mbx->numMsgs;
+		mbx->count--;
+		pthread_cond_broadcast(&mbx->m.cond);
+	}
+	pthread_mutex_unlock(&mbx->m.lock);
+	return ok;
+}
+
+/* GateMutex */
+
+struct GateMutex_Object {
+	pthread_mutex_t lock;
+};
+
+GateMutex_Handle GateMutex_create(const GateMutex_Params *params, Error_Block *eb)
+{
+	struct GateMutex_Object *gate = malloc(sizeof(struct GateMutex_Object));
+
+	if (gate != NULL) {
+		pthread_mutex_init(&gate->lock, NULL);
+	}
+	return gate;
+}
+
+Void GateMutex_delete(GateMutex_Handle *handle)
+{
+	pthread_mutex_destroy(&(*handle)->lock);
+	free(*handle);
+	*handle = NULL;
+}
+
+IArg GateMutex_enter(GateMutex_Handle gate)
+{
+	pthread_mutex_lock(&gate->lock);
+	return 0;
+}
+
+Void GateMutex_leave(GateMutex_Handle gate, IArg key)
+{
+	pthread_mutex_unlock(&gate->lock);
+}
@@ -0,0 +1,91 @@
+/*
+ * @file tirtos_virtual.c
+ * @brief Single-threaded TI-RTOS stand-in running on a virtual clock
+ * @details Sleeps, pends and bus transfers advance the clock instead of taking real time, so deadline behavior
+ *          is deterministic and exact.  Like SYS/BIOS, Task_sleep() and timed Semaphore_pend() wake on a tick
+ *          boundary (one tick = 1000us).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <xdc/std.h>
+#include <xdc/runtime/Timestamp.h>
+#include <ti/sysbios/BIOS.h>
+#include <ti/sysbios/knl/Clock.h>
+#include <ti/sysbios/knl/Task.h>
+#include <ti/sysbios/knl/Semaphore.h>
+
+#include "sim_bus.h"
+
+static Uint64 _nowUs;
+
+Uint64 Host_nowUs(Void)
+{
+	return _nowUs;
+}
+
+Void Host_busDelayUs(Uint32 us)
+{
+	_nowUs += us;
+}
+
+UInt32 Clock_getTicks(Void)
+{
+	return (UInt32)(_nowUs / 1000);
+}
+
+UInt32 Timestamp_get32(Void)
+{
+	return (UInt32)_nowUs;
+}
+
+/// @brief Advance to the <ticks>-th tick boundary from now
+static Void _sleepTicks(UInt32 ticks)
+{
+	_nowUs = (_nowUs / 1000 + ticks) * 1000;
+}
+
+Void Task_sleep(UInt32 ticks)
+{
+	if (ticks > 0) {
+		_sleepTicks(ticks);
+	}
+}
+
+Void Semaphore_Params_init(Semaphore_Params *params)
+{
+	params->mode = Semaphore_Mode_COUNTING;
+}
+
+Void Semaphore_construct(Semaphore_Struct *sem, Int count, const Semaphore_Params *params)
+{
+	sem->mode = params != NULL ? params->mode : Semaphore_Mode_COUNTING;
+	sem->count = count;
+	sem->os = NULL;
+}
+
+/// @details With a single thread nothing can post while we wait, so a timed pend that finds the count at zero
+///          simply lets the timeout elapse.  Waiting forever on such a semaphore is a deadlock in the code under test.
+Bool Semaphore_pend(Semaphore_Handle sem, UInt timeout)
+{
+	if (sem->count > 0) {
+		sem->count--;
+		return true;
+	}
+	if (timeout == BIOS_WAIT_FOREVER) {
+		fprintf(stderr, "tirtos_virtual: Semaphore_pend(BIOS_WAIT_FOREVER) would never return\n");
+		abort();
+	}
+	_sleepTicks(timeout);
+	return false;
+}
+
+Void Semaphore_post(Semaphore_Handle sem)
+{
+	if (sem->mode == Semaphore_Mode_BINARY) {
+		sem->count = 1;
+	} else {
+		sem->count++;
+	}
+}